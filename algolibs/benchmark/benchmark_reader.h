@@ -68,7 +68,7 @@ labyrinth::NodeId objectiveIdFromLocation(const labyrinth::MazeGraph& graph,
     if (instance_objective_location == labyrinth::Location(-1, -1)) {
         return graph.getLeftover().node_id;
     } else {
-        return graph.getNode(instance_objective_location).node_id;
+        return graph.getNodeId(instance_objective_location);
     }
 }
 
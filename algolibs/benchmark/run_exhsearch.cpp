@@ -14,18 +14,38 @@ using namespace labyrinth;
 namespace fs = std::filesystem;
 
 static void show_usage(const std::string& name) {
-    std::cerr << "Usage: " << name << " INSTANCE_FILE" << std::endl
+    std::cerr << "Usage: " << name << " INSTANCE_FILE [MODE [MAX_MEMORY_MB]]" << std::endl
               << "Where: " << std::endl
-              << "\tINSTANCE_FILE\t\tis a file ending with .txt in a specific format." << std::endl;
+              << "\tINSTANCE_FILE\t\tis a file ending with .txt in a specific format." << std::endl
+              << "\tMODE\t\t\tis one of bfs (default), iddfs, informed." << std::endl
+              << "\tMAX_MEMORY_MB\t\tlimits the memory of the breadth-first search, 0 (default) for no limit."
+              << std::endl
+              << "Prints the instance name, the number of actions, the numbers of expanded, generated, and pruned"
+              << " game states, and the mode which has finished the search, separated by commas." << std::endl;
 }
 
-void run(const std::string& filename) {
+static std::string modeName(solvers::exhsearch::SearchMode mode) {
+    switch (mode) {
+    case solvers::exhsearch::SearchMode::iterative_deepening:
+        return "iddfs";
+    case solvers::exhsearch::SearchMode::informed:
+        return "informed";
+    default:
+        return "bfs";
+    }
+}
+
+void run(const std::string& filename, const solvers::exhsearch::SearchOptions& options) {
     const bench::BenchmarkInstance instance = bench::reader::readInstance(filename);
     MazeGraph graph = bench::reader::buildMazeGraph(instance);
     auto objective_id = bench::reader::objectiveIdFromLocation(graph, instance.objective);
     Location player_location = instance.player_locations[0];
     solvers::SolverInstance solver_instance{graph, player_location, Location{-1, -1}, objective_id, Location{-1, -1}};
-    auto best_actions = solvers::exhsearch::findBestActions(solver_instance);
+    const auto result = solvers::exhsearch::findBestActionsWithOptions(solver_instance, options);
+    const auto& best_actions = result.actions;
+    std::cout << instance.name << "," << best_actions.size() << "," << result.statistics.expanded_states << ","
+              << result.statistics.generated_states << "," << result.statistics.pruned_states << ","
+              << modeName(result.finished_mode) << std::endl;
     if (best_actions.size() != instance.depth) {
         std::cerr << "Search depth mismatch for instance " << instance.name << ", expected " << instance.depth
                   << ", found" << best_actions.size() << std::endl;
@@ -37,6 +57,21 @@ int main(int argc, char* argv[]) {
         show_usage(argv[0]);
         return 1;
     }
-    run(argv[1]);
+    solvers::exhsearch::SearchOptions options;
+    if (argc > 2) {
+        const std::string mode_name{argv[2]};
+        if (mode_name == "iddfs") {
+            options.mode = solvers::exhsearch::SearchMode::iterative_deepening;
+        } else if (mode_name == "informed") {
+            options.mode = solvers::exhsearch::SearchMode::informed;
+        } else if (mode_name != "bfs") {
+            show_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (argc > 3) {
+        options.max_memory_bytes = std::stoul(argv[3]) * 1024 * 1024;
+    }
+    run(argv[1], options);
     return 0;
 }
@@ -0,0 +1,192 @@
+#include "bitboard.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace labyrinth {
+
+namespace { // anonymous namespace for file-internal linkage
+
+// The following functions take the extent either as runtime value or as StaticExtent,
+// cf. dispatchExtent(). In the latter case, the compiler is able to unroll the loops and fold the shifts.
+
+template <typename Extent>
+void fillPlanes(const MazeGraph& graph,
+                Extent extent,
+                BitBoard& north,
+                BitBoard& east,
+                BitBoard& south,
+                BitBoard& west,
+                BitBoard& last_column) {
+    const auto extent_value = static_cast<MazeGraph::ExtentType>(extent);
+    BitBoard::IndexType index = 0;
+    for (auto row = 0; row < extent_value; ++row) {
+        for (auto column = 0; column < extent_value; ++column, ++index) {
+            const auto out_paths = graph.getRotatedOutPaths(Location{row, column});
+            if (out_paths & static_cast<OutPathsIntegerType>(OutPaths::North)) {
+                north.set(index);
+            }
+            if (out_paths & static_cast<OutPathsIntegerType>(OutPaths::East)) {
+                east.set(index);
+            }
+            if (out_paths & static_cast<OutPathsIntegerType>(OutPaths::South)) {
+                south.set(index);
+            }
+            if (out_paths & static_cast<OutPathsIntegerType>(OutPaths::West)) {
+                west.set(index);
+            }
+        }
+        last_column.set(index - 1);
+    }
+}
+
+template <typename Extent>
+BitBoard growCells(const BitBoard& cells, const BitBoard& east_links, const BitBoard& south_links, Extent extent) {
+    const auto row_shift = static_cast<BitBoard::IndexType>(extent);
+    return cells | ((cells & east_links) << 1) | ((cells >> 1) & east_links) | ((cells & south_links) << row_shift) |
+           ((cells >> row_shift) & south_links);
+}
+
+template <typename Extent>
+BitBoard floodFillCells(BitBoard cells, const BitBoard& east_links, const BitBoard& south_links, Extent extent) {
+    for (BitBoard grown = growCells(cells, east_links, south_links, extent); grown != cells;
+         grown = growCells(cells, east_links, south_links, extent)) {
+        cells = grown;
+    }
+    return cells;
+}
+
+template <typename Extent>
+bool connectsCells(BitBoard::IndexType source,
+                   BitBoard::IndexType target,
+                   const BitBoard& east_links,
+                   const BitBoard& south_links,
+                   Extent extent) {
+    BitBoard cells = BitBoard::singleBit(source);
+    while (!cells.test(target)) {
+        const BitBoard grown = growCells(cells, east_links, south_links, extent);
+        if (grown == cells) {
+            return false;
+        }
+        cells = grown;
+    }
+    return true;
+}
+
+template <typename Extent>
+bool connectsCellsBidirectional(BitBoard::IndexType source,
+                                BitBoard::IndexType target,
+                                const BitBoard& east_links,
+                                const BitBoard& south_links,
+                                Extent extent) {
+    BitBoard from_source = BitBoard::singleBit(source);
+    BitBoard from_target = BitBoard::singleBit(target);
+    while ((from_source & from_target).none()) {
+        const BitBoard grown = growCells(from_source, east_links, south_links, extent);
+        if (grown == from_source) {
+            return false;
+        }
+        from_source = from_target;
+        from_target = grown;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+BitBoard BitBoard::lowestBits(IndexType num_bits) noexcept {
+    if (num_bits == 0) {
+        return BitBoard{};
+    } else if (num_bits < 64) {
+        return BitBoard{(WordType{1} << num_bits) - 1, 0};
+    } else if (num_bits == 64) {
+        return BitBoard{~WordType{0}, 0};
+    } else if (num_bits < capacity) {
+        return BitBoard{~WordType{0}, (WordType{1} << (num_bits - 64)) - 1};
+    }
+    return BitBoard{~WordType{0}, ~WordType{0}};
+}
+
+BitBoard BitBoard::singleBit(IndexType index) noexcept {
+    BitBoard result{};
+    result.set(index);
+    return result;
+}
+
+BitBoard::IndexType BitBoard::count() const noexcept {
+    IndexType result = 0;
+    forEach([&result](IndexType) { ++result; });
+    return result;
+}
+
+BitBoard::IndexType BitBoard::countTrailingZeros(WordType word) noexcept {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<IndexType>(index);
+#else
+    return static_cast<IndexType>(__builtin_ctzll(word));
+#endif
+}
+
+MazeBitBoard::MazeBitBoard(const MazeGraph& graph) : extent_{graph.getExtent()} {
+    if (extent_ == 0) {
+        return;
+    }
+    dispatchExtent(extent_,
+                   [&](auto extent) { fillPlanes(graph, extent, north_, east_, south_, west_, last_column_); });
+    updateLinks();
+}
+
+void MazeBitBoard::openCells(const BitBoard& cells) noexcept {
+    north_ |= cells;
+    east_ |= cells;
+    south_ |= cells;
+    west_ |= cells;
+    updateLinks();
+}
+
+void MazeBitBoard::updateLinks() noexcept {
+    east_links_ = east_ & (west_ >> 1) & ~last_column_;
+    south_links_ = south_ & (north_ >> static_cast<IndexType>(extent_));
+}
+
+BitBoard MazeBitBoard::grow(const BitBoard& cells) const noexcept {
+    return growCells(cells, east_links_, south_links_, extent_);
+}
+
+BitBoard MazeBitBoard::floodFill(BitBoard cells) const noexcept {
+    if (extent_ == 0) {
+        return cells;
+    }
+    return dispatchExtent(extent_,
+                          [&](auto extent) { return floodFillCells(cells, east_links_, south_links_, extent); });
+}
+
+bool MazeBitBoard::connects(IndexType source, IndexType target) const noexcept {
+    return dispatchExtent(extent_, [&](auto extent) {
+        return connectsCells(source, target, east_links_, south_links_, extent);
+    });
+}
+
+bool MazeBitBoard::connectsBidirectional(IndexType source, IndexType target) const noexcept {
+    return dispatchExtent(extent_, [&](auto extent) {
+        return connectsCellsBidirectional(source, target, east_links_, south_links_, extent);
+    });
+}
+
+const BitBoard& MazeBitBoard::getPlane(OutPaths out_path) const noexcept {
+    switch (out_path) {
+    case OutPaths::North:
+        return north_;
+    case OutPaths::East:
+        return east_;
+    case OutPaths::South:
+        return south_;
+    default:
+        return west_;
+    }
+}
+
+} // namespace labyrinth
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "location.h"
+#include "maze_graph.h"
+
+#include <cstdint>
+
+namespace labyrinth {
+
+/// A set of up to 128 maze cells, stored in two 64-bit words.
+/// Cells are indexed row-wise, i.e. the cell at (row, column) has index row * extent + column.
+class BitBoard {
+public:
+    using WordType = uint64_t;
+    using IndexType = unsigned int;
+
+    static constexpr IndexType capacity = 128;
+
+    constexpr BitBoard() noexcept = default;
+    constexpr explicit BitBoard(WordType low, WordType high) noexcept : low_{low}, high_{high} {}
+
+    /// Returns a board with the lowest num_bits bits set.
+    static BitBoard lowestBits(IndexType num_bits) noexcept;
+
+    static BitBoard singleBit(IndexType index) noexcept;
+
+    constexpr bool test(IndexType index) const noexcept {
+        return index < 64 ? (low_ >> index) & 1u : (high_ >> (index - 64)) & 1u;
+    }
+
+    constexpr void set(IndexType index) noexcept {
+        if (index < 64) {
+            low_ |= WordType{1} << index;
+        } else {
+            high_ |= WordType{1} << (index - 64);
+        }
+    }
+
+    constexpr bool none() const noexcept { return (low_ | high_) == 0; }
+
+    constexpr bool any() const noexcept { return !none(); }
+
+    IndexType count() const noexcept;
+
+    /// Calls function(index) for each set bit, in ascending order.
+    template <typename Function>
+    void forEach(Function function) const {
+        forEachInWord(low_, 0, function);
+        forEachInWord(high_, 64, function);
+    }
+
+    constexpr BitBoard operator&(const BitBoard& other) const noexcept {
+        return BitBoard{low_ & other.low_, high_ & other.high_};
+    }
+
+    constexpr BitBoard operator|(const BitBoard& other) const noexcept {
+        return BitBoard{low_ | other.low_, high_ | other.high_};
+    }
+
+    constexpr BitBoard operator~() const noexcept { return BitBoard{~low_, ~high_}; }
+
+    constexpr BitBoard& operator&=(const BitBoard& other) noexcept { return *this = *this & other; }
+
+    constexpr BitBoard& operator|=(const BitBoard& other) noexcept { return *this = *this | other; }
+
+    /// Shifts towards higher indices. Expects 0 < shift < 64.
+    constexpr BitBoard operator<<(IndexType shift) const noexcept {
+        return BitBoard{low_ << shift, (high_ << shift) | (low_ >> (64 - shift))};
+    }
+
+    /// Shifts towards lower indices. Expects 0 < shift < 64.
+    constexpr BitBoard operator>>(IndexType shift) const noexcept {
+        return BitBoard{(low_ >> shift) | (high_ << (64 - shift)), high_ >> shift};
+    }
+
+    constexpr bool operator==(const BitBoard& other) const noexcept {
+        return low_ == other.low_ && high_ == other.high_;
+    }
+
+    constexpr bool operator!=(const BitBoard& other) const noexcept { return !(*this == other); }
+
+    /// Returns the index of the lowest set bit of a non-zero word.
+    static IndexType countTrailingZeros(WordType word) noexcept;
+
+private:
+
+    template <typename Function>
+    static void forEachInWord(WordType word, IndexType base, Function& function) {
+        while (word != 0) {
+            function(base + countTrailingZeros(word));
+            word &= word - 1;
+        }
+    }
+
+    WordType low_{0};
+    WordType high_{0};
+};
+
+/// Alternative representation of a maze for computing reachability with bit-parallel operations.
+///
+/// For each of the four directions, it keeps one bit plane which contains the cells having an (already rotated)
+/// out path in that direction. A cell is connected to its eastern neighbor, if the cell is open to the east and
+/// the neighbor is open to the west. The reachable cells are computed by growing a set of cells along all such
+/// connections until a fixpoint is reached.
+/// Only mazes with an extent of up to 11 (121 cells) can be represented.
+/// The planes are kept on the stack, and the loops are specialized for the common extents, cf. dispatchExtent().
+class MazeBitBoard {
+public:
+    using IndexType = BitBoard::IndexType;
+
+    static constexpr MazeGraph::ExtentType max_extent = 11;
+
+    static bool supportsExtent(MazeGraph::ExtentType extent) noexcept { return extent >= 0 && extent <= max_extent; }
+
+    explicit MazeBitBoard(const MazeGraph& graph);
+
+    IndexType toIndex(const Location& location) const noexcept {
+        return static_cast<IndexType>(location.getRow() * extent_ + location.getColumn());
+    }
+
+    Location toLocation(IndexType index) const noexcept {
+        return Location{index / static_cast<IndexType>(extent_), index % static_cast<IndexType>(extent_)};
+    }
+
+    /// Returns all cells which are connected to at least one of the given cells.
+    BitBoard floodFill(BitBoard cells) const noexcept;
+
+    /// Returns the given cells together with the cells which can be reached from them in one step.
+    BitBoard grow(const BitBoard& cells) const noexcept;
+
+    /// Checks if the target cell can be reached from the source cell.
+    /// Stops growing the reached cells as soon as the target is contained.
+    bool connects(IndexType source, IndexType target) const noexcept;
+
+    /// Same as connects(), but grows the cells reached from the source and from the target alternately,
+    /// until they intersect. Requires about half as many growth steps for long paths.
+    bool connectsBidirectional(IndexType source, IndexType target) const noexcept;
+
+    /// Opens the given cells in all directions, as if they contained crossings.
+    void openCells(const BitBoard& cells) noexcept;
+
+    MazeGraph::ExtentType getExtent() const noexcept { return extent_; }
+
+    const BitBoard& getPlane(OutPaths out_path) const noexcept;
+
+private:
+    void updateLinks() noexcept;
+
+    MazeGraph::ExtentType extent_;
+    BitBoard north_;
+    BitBoard east_;
+    BitBoard south_;
+    BitBoard west_;
+    BitBoard last_column_;
+    // cells which are connected to their eastern and southern neighbor, respectively
+    BitBoard east_links_;
+    BitBoard south_links_;
+};
+
+} // namespace labyrinth
@@ -0,0 +1,85 @@
+#include "bitsliced.h"
+
+namespace labyrinth {
+
+void BitSlicedMazes::setAllBoards(const MazeGraph& graph) {
+    extent_ = graph.getExtent();
+    const size_t num_cells = graph.getLayout().getNumberOfCells();
+    planes_.resize(num_cells * 4);
+    east_links_.resize(num_cells);
+    south_links_.resize(num_cells);
+    reached_.assign(num_cells, 0);
+    for (size_t cell = 0; cell < num_cells; ++cell) {
+        const auto out_paths = graph.getRotatedOutPaths(graph.getLayout().toLocation(static_cast<CellIndex>(cell)));
+        for (size_t direction = 0; direction < 4; ++direction) {
+            planes_[cell * 4 + direction] = ((out_paths >> direction) & 1u) ? ~WordType{0} : 0;
+        }
+    }
+    are_links_outdated_ = true;
+}
+
+void BitSlicedMazes::updateLinks() noexcept {
+    const auto extent = static_cast<size_t>(extent_);
+    const size_t num_cells = reached_.size();
+    constexpr size_t north = 0;
+    constexpr size_t east = 1;
+    constexpr size_t south = 2;
+    constexpr size_t west = 3;
+    for (size_t cell = 0; cell < num_cells; ++cell) {
+        const bool is_last_column = cell % extent == extent - 1;
+        east_links_[cell] = is_last_column ? 0 : planes_[cell * 4 + east] & planes_[(cell + 1) * 4 + west];
+        const bool is_last_row = cell + extent >= num_cells;
+        south_links_[cell] = is_last_row ? 0 : planes_[cell * 4 + south] & planes_[(cell + extent) * 4 + north];
+    }
+    are_links_outdated_ = false;
+}
+
+void BitSlicedMazes::floodFill() noexcept {
+    // Alternating forward and backward sweeps, in which each cell takes over the reached boards of its already swept
+    // neighbors. A sweep follows paths in its direction over arbitrary distances.
+    const auto extent = static_cast<size_t>(extent_);
+    if (are_links_outdated_) {
+        updateLinks();
+    }
+    WordType changed;
+    do {
+        changed = 0;
+        for (size_t row = 0; row < extent; ++row) {
+            for (size_t column = 0; column < extent; ++column) {
+                const size_t cell = row * extent + column;
+                WordType reached = reached_[cell];
+                if (column > 0) {
+                    reached |= reached_[cell - 1] & east_links_[cell - 1];
+                }
+                if (row > 0) {
+                    reached |= reached_[cell - extent] & south_links_[cell - extent];
+                }
+                changed |= reached ^ reached_[cell];
+                reached_[cell] = reached;
+            }
+        }
+        for (size_t row = extent; row-- > 0;) {
+            for (size_t column = extent; column-- > 0;) {
+                const size_t cell = row * extent + column;
+                WordType reached = reached_[cell];
+                if (column + 1 < extent) {
+                    reached |= reached_[cell + 1] & east_links_[cell];
+                }
+                if (row + 1 < extent) {
+                    reached |= reached_[cell + extent] & south_links_[cell];
+                }
+                changed |= reached ^ reached_[cell];
+                reached_[cell] = reached;
+            }
+        }
+    } while (changed != 0);
+}
+
+void BitSlicedMazes::getReachedCells(size_t board_index, std::vector<WordType>& bits) const {
+    bits.assign((reached_.size() + 63) / 64, 0);
+    for (size_t cell = 0; cell < reached_.size(); ++cell) {
+        bits[cell / 64] |= ((reached_[cell] >> board_index) & 1u) << (cell % 64);
+    }
+}
+
+} // namespace labyrinth
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "cell_layout.h"
+#include "maze_graph.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace labyrinth {
+
+/// Computes the reachable cells of up to 64 mazes of the same extent simultaneously.
+///
+/// The mazes (boards) are stored bit-sliced: for each cell, one word contains a property of this cell in all boards,
+/// with bit b belonging to board b. There is one such word per cell and direction for the (already rotated) out paths,
+/// and one for the reached cells. The reached cells of all boards are then grown with a few bitwise operations per
+/// cell, independent of the number of boards.
+/// The boards are typically the children of a game state. They only differ from their parent in one shifted line, so
+/// they are initialized with the parent maze, and only the cells of the shifted line are set individually.
+class BitSlicedMazes {
+public:
+    using WordType = uint64_t;
+
+    static constexpr size_t max_boards = 64;
+
+    /// Initializes all boards with the given maze, and clears their reached cells.
+    void setAllBoards(const MazeGraph& graph);
+
+    /// Sets the rotated out paths of a cell in one board.
+    void setOutPaths(size_t board_index, CellIndex cell, OutPathsIntegerType out_paths) noexcept {
+        const WordType board_bit = WordType{1} << board_index;
+        are_links_outdated_ = true;
+        for (size_t direction = 0; direction < 4; ++direction) {
+            WordType& plane = planes_[cell * 4 + direction];
+            plane = (plane & ~board_bit) | (((out_paths >> direction) & 1u) ? board_bit : 0);
+        }
+    }
+
+    void addSource(size_t board_index, CellIndex cell) noexcept { reached_[cell] |= WordType{1} << board_index; }
+
+    /// Grows the reached cells of all boards along their connections, until none of the boards changes any more.
+    /// Sources can be added between subsequent calls, e.g. to label the components of the boards one by one.
+    void floodFill() noexcept;
+
+    bool isReached(size_t board_index, CellIndex cell) const noexcept { return (reached_[cell] >> board_index) & 1u; }
+
+    /// Returns the reached cells of a board as bitset over the cell indices, in words of 64 cells each.
+    void getReachedCells(size_t board_index, std::vector<WordType>& bits) const;
+
+    /// Returns the reached cells of all boards, as one word per cell.
+    const std::vector<WordType>& getReachedSlices() const noexcept { return reached_; }
+
+    size_t getNumberOfCells() const noexcept { return reached_.size(); }
+
+private:
+    /// Computes the connections to the eastern and southern neighbors from the out paths.
+    void updateLinks() noexcept;
+
+    MazeGraph::ExtentType extent_{0};
+    // out paths of each cell in the order north, east, south, west, cf. OutPaths
+    std::vector<WordType> planes_;
+    // boards in which a cell is connected to its eastern and southern neighbor, respectively
+    std::vector<WordType> east_links_;
+    std::vector<WordType> south_links_;
+    std::vector<WordType> reached_;
+    bool are_links_outdated_{true};
+};
+
+} // namespace labyrinth
@@ -11,7 +11,13 @@ PUBLIC_API struct CAction find_action(struct CGraph* c_graph,
                                                        labyrinth::Location{-1, -1},
                                                        objective_id,
                                                        mapLocation(*c_previous_shift_location)};
-    auto best_actions = labyrinth::solvers::exhsearch::findBestActions(solver_instance);
+    // When the search is aborted, e.g. by a time limit of the caller, the first action towards the objective is still
+    // better than none.
+    labyrinth::solvers::exhsearch::SearchOptions options;
+    options.return_partial_plan = true;
+    // The result does not depend on the number of threads, so all cores are used.
+    options.num_threads = 0;
+    auto best_actions = labyrinth::solvers::exhsearch::findBestActionsWithOptions(solver_instance, options).actions;
 
     if (best_actions.empty()) {
         return errorAction();
@@ -0,0 +1,29 @@
+#include "cell_layout.h"
+
+#include "maze_graph.h"
+
+namespace labyrinth {
+
+CellLayout::CellLayout(ExtentType extent) :
+    extent_{extent}, num_cells_{static_cast<size_t>(extent * extent)}, border_slots_(num_cells_, no_slot) {
+    locations_.reserve(num_cells_);
+    for (auto row = 0; row < extent_; ++row) {
+        for (auto column = 0; column < extent_; ++column) {
+            locations_.emplace_back(row, column);
+        }
+    }
+    CellIndex num_slots = 0;
+    for (size_t shift_cell = 0; shift_cell < num_cells_; ++shift_cell) {
+        const Location shift_location = locations_[shift_cell];
+        if (opposingShiftLocation(shift_location, extent_) == shift_location) {
+            continue;
+        }
+        border_slots_[shift_cell] = num_slots++;
+        for (size_t cell = 0; cell < num_cells_; ++cell) {
+            const Location translated = translateLocationByShift(locations_[cell], shift_location, extent_);
+            shift_translations_.push_back(toCellIndex(translated));
+        }
+    }
+}
+
+} // namespace labyrinth
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "location.h"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace labyrinth {
+
+/// Dense index of a maze cell. Cells are numbered row-wise, i.e. the cell at (row, column) has index
+/// row * extent + column. 16 bits suffice for all supported extents (up to 31).
+using CellIndex = uint16_t;
+
+/// Tables which relate cell indices and locations of a maze with a fixed extent.
+///
+/// Besides the conversion between the two representations, it provides, for each cell on the border,
+/// the translation of all cells when the maze is shifted at that cell, cf. translateLocationByShift().
+/// The tables only depend on the extent, and are shared between copies of a MazeGraph.
+class CellLayout {
+public:
+    using ExtentType = int32_t;
+
+    static constexpr CellIndex no_cell = std::numeric_limits<CellIndex>::max();
+
+    explicit CellLayout(ExtentType extent);
+
+    CellIndex toCellIndex(const Location& location) const noexcept {
+        return static_cast<CellIndex>(location.getRow() * extent_ + location.getColumn());
+    }
+
+    Location toLocation(CellIndex cell) const noexcept { return locations_[cell]; }
+
+    /// Returns the cell which the given cell is moved to, when the maze is shifted at the given shift location.
+    /// Returns the given cell for shift locations which are not on the border.
+    CellIndex translateByShift(CellIndex cell, CellIndex shift_cell) const noexcept {
+        const auto slot = border_slots_[shift_cell];
+        if (slot == no_slot) {
+            return cell;
+        }
+        return shift_translations_[slot * num_cells_ + cell];
+    }
+
+    ExtentType getExtent() const noexcept { return extent_; }
+
+    size_t getNumberOfCells() const noexcept { return num_cells_; }
+
+private:
+    static constexpr CellIndex no_slot = std::numeric_limits<CellIndex>::max();
+
+    ExtentType extent_;
+    size_t num_cells_;
+    std::vector<Location> locations_;
+    // maps each cell to its position in shift_translations_, or to no_slot for inner cells
+    std::vector<CellIndex> border_slots_;
+    // one table of num_cells_ entries per border cell
+    std::vector<CellIndex> shift_translations_;
+};
+
+} // namespace labyrinth
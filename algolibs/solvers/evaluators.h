@@ -24,7 +24,7 @@ public:
      * The player has not actively reached the objective in his last move.
      */
     Evaluation evaluate(const GameTreeNode& node) const override {
-        if (node.getGraph().getNode(node.getOpponentLocation()).node_id == objective_id_) {
+        if (node.getGraph().getNodeId(node.getOpponentLocation()) == objective_id_) {
             return Evaluation{-1, true};
         } else {
             return 0;
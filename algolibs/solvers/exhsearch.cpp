@@ -1,25 +1,43 @@
 #include "exhsearch.h"
 
+#include "bitboard.h"
 #include "graph_algorithms.h"
 
 #include "location.h"
 #include "maze_graph.h"
+#include "zobrist.h"
 
 #include <algorithm>
-#include <memory>
-#include <queue>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
 #include <vector>
 
 // The algorithm searches for a path reaching the objective in a tree of game states.
 // For each analyzed succession of shift actions, it keeps track of all reachable locations.
 // The root of this game tree is the initial graph given in the constructor.
-// Each other game state is reached from its parent game state with a GameStateTransition,
-// i.e. with a shift action and the set of then-reachable nodes.
+// Each other game state is reached from its parent game state with a shift action,
+// and stores the set of then-reachable nodes. All states are kept in a StateTree.
 
-// To be able to reconstruct the player actions,
-// the reachable nodes have to include their source node in the previous game state
-// Therefore, they are computed and stored as pairs, where the second entry is the NodeId of the reached node,
-// and the first entry is the index of the source node in the respective parent array.
+// The reachable nodes of a game state are stored as bitset over the cell indices.
+// To reconstruct the player actions, the reachable nodes along the path to the objective are computed again,
+// together with their source node in the previous game state, cf. reconstructActions().
+// Locations are only used when the player actions are reconstructed.
+// The reachable nodes of all children of a game state are computed at once, cf. reachable::allChildrenReachability().
+// Optionally, states which do not reach any new locations compared to an already queued state are dropped,
+// cf. ClosedSet.
+// With a memory limit, the breadth-first search releases all states before a level which would exceed it, and
+// continues as iterative deepening search, which only keeps the states of the current path.
+// Optionally, the searches track the plan to the state closest to the objective, which is returned if they are
+// aborted, cf. PartialPlan.
 
 namespace labyrinth {
 
@@ -29,94 +47,1036 @@ namespace exhsearch {
 
 namespace { // anonymous namespace for file-internal linkage
 
-struct GameStateNode;
-using StatePtr = std::shared_ptr<GameStateNode>;
+using StateIndex = uint32_t;
+using WordType = reachable::ChildrenReachability::WordType;
 
-struct GameStateNode {
-    explicit GameStateNode(StatePtr parent,
-                           const ShiftAction& shift,
-                           const std::vector<reachable::ReachableNode>& reached_nodes) :
-        parent{parent}, shift{shift}, reached_nodes{reached_nodes} {}
-    explicit GameStateNode() noexcept : parent{nullptr} {}
+/// Game state, which is reached from its parent state by a shift.
+/// The reachable nodes are stored in the StateTree.
+struct GameState {
+    static constexpr StateIndex no_parent = std::numeric_limits<StateIndex>::max();
 
-    StatePtr parent{nullptr};
-    ShiftAction shift{};
-    std::vector<reachable::ReachableNode> reached_nodes;
+    bool isRoot() const noexcept { return parent == no_parent; }
 
-    bool isRoot() const noexcept { return parent == nullptr; }
+    StateIndex parent;
+    ShiftAction shift;
 };
 
-using QueueType = std::queue<std::shared_ptr<GameStateNode>>;
+/// Stores all game states of a search in a single array, linked by the indices of their parents.
+/// The reachable nodes of each state are stored as bitset over the cell indices, in a single pool of words.
+/// States are appended in the order of their creation, i.e. for a breadth-first search, the states themselves form
+/// the queue of the search. All memory is released at once when the tree is destroyed.
+class StateTree {
+public:
+    explicit StateTree(size_t num_cells) : num_words_{(num_cells + 63) / 64} {}
 
-MazeGraph createGraphFromState(const MazeGraph& base_graph, StatePtr current_state) {
+    StateIndex addRoot(const ShiftAction& previous_shift, CellIndex player_cell) {
+        reached_bits_.resize(reached_bits_.size() + num_words_, 0);
+        reached_bits_[reached_bits_.size() - num_words_ + player_cell / 64] |= WordType{1} << (player_cell % 64);
+        return addState(GameState::no_parent, previous_shift);
+    }
+
+    StateIndex addChild(StateIndex parent, const ShiftAction& shift, const WordType* reached_bits) {
+        reached_bits_.insert(reached_bits_.end(), reached_bits, reached_bits + num_words_);
+        return addState(parent, shift);
+    }
+
+    size_t size() const noexcept { return states_.size(); }
+
+    const GameState& getState(StateIndex state_index) const noexcept { return states_[state_index]; }
+
+    const WordType* getReachedBits(StateIndex state_index) const noexcept {
+        return reached_bits_.data() + state_index * num_words_;
+    }
+
+    size_t getNumberOfWords() const noexcept { return num_words_; }
+
+    /// Allocates the memory for the given total number of states at once.
+    void reserve(size_t num_states) {
+        states_.reserve(num_states);
+        reached_bits_.reserve(num_states * num_words_);
+    }
+
+    size_t getBytesPerState() const noexcept { return sizeof(GameState) + num_words_ * sizeof(WordType); }
+
+    size_t getMemoryBytes() const noexcept {
+        return states_.capacity() * sizeof(GameState) + reached_bits_.capacity() * sizeof(WordType);
+    }
+
+private:
+    StateIndex addState(StateIndex parent, const ShiftAction& shift) {
+        states_.push_back(GameState{parent, shift});
+        return static_cast<StateIndex>(states_.size() - 1);
+    }
+
+    size_t num_words_;
+    std::vector<GameState> states_;
+    std::vector<WordType> reached_bits_;
+};
+
+/// Keeps the maze of one state of a StateTree, and moves it to other states by undoing and applying shifts in place.
+/// In breadth-first order, consecutive states are mostly siblings, so that moving to the next state usually costs one
+/// undo and one shift, instead of copying the initial maze and replaying all shifts from the root.
+class TreeGraph {
+public:
+    explicit TreeGraph(const MazeGraph& base_graph) : graph_{base_graph} {}
+
+    const MazeGraph& getGraph() const noexcept { return graph_; }
+
+    void moveTo(const StateTree& tree, StateIndex state_index) {
+        // path from the state to the root, excluding the root
+        target_path_.clear();
+        for (auto cur = state_index; !tree.getState(cur).isRoot(); cur = tree.getState(cur).parent) {
+            target_path_.push_back(cur);
+        }
+        size_t num_common_steps = 0;
+        while (num_common_steps < path_.size() && num_common_steps < target_path_.size() &&
+               path_[num_common_steps].state == target_path_[target_path_.size() - 1 - num_common_steps]) {
+            ++num_common_steps;
+        }
+        while (path_.size() > num_common_steps) {
+            graph_.undo(path_.back().undo_record);
+            path_.pop_back();
+        }
+        for (auto step = target_path_.rbegin() + num_common_steps; step != target_path_.rend(); ++step) {
+            const ShiftAction& shift = tree.getState(*step).shift;
+            path_.push_back(Step{*step, graph_.applyShift(shift.location, shift.rotation)});
+        }
+    }
+
+private:
+    struct Step {
+        StateIndex state;
+        ShiftUndoRecord undo_record;
+    };
+
+    MazeGraph graph_;
+    // path from the root to the current state, excluding the root
+    std::vector<Step> path_;
+    std::vector<StateIndex> target_path_;
+};
+
+void collectPlayerCells(const StateTree& tree, StateIndex state_index, std::vector<CellIndex>& player_cells) {
+    player_cells.clear();
+    const WordType* reached_bits = tree.getReachedBits(state_index);
+    for (size_t word_index = 0; word_index < tree.getNumberOfWords(); ++word_index) {
+        for (WordType word = reached_bits[word_index]; word != 0; word &= word - 1) {
+            player_cells.push_back(static_cast<CellIndex>(word_index * 64 + BitBoard::countTrailingZeros(word)));
+        }
+    }
+}
+
+/// Identity of a state in the ClosedSet, which consists of its maze and its previous shift, cf. stateKey().
+struct StateKey {
+    zobrist::HashType hash{0};
+    // second, independent hash, which tells apart states whose hashes collide
+    zobrist::HashType verification{0};
+
+    bool operator==(const StateKey& other) const noexcept {
+        return hash == other.hash && verification == other.verification;
+    }
+};
+
+/// Keeps the reached cells of all queued states, in order to drop states which are dominated by one of them.
+///
+/// States are identified by the hash of their maze and their previous shift, which restricts the next shift.
+/// A state is dominated by a queued state with the same identity, if its reached cells are a subset of those of
+/// the queued state. As the search proceeds breadth-first, the queued state is not deeper than the dominated state,
+/// and each plan from the dominated state is also possible from the queued state.
+/// A state is only compared to states whose verification hash is equal as well, so that a collision of the 64-bit
+/// hashes does not drop a state. Both hashes would have to collide at once.
+class ClosedSet {
+public:
+    ClosedSet() : slots_(initial_capacity) {}
+
+    /// Inserts a state, unless it is dominated by a previously inserted state. Returns if the state has been inserted.
+    bool insert(const StateKey& key, const WordType* reached_bits, size_t num_words) {
+        Slot& slot = findSlot(key);
+        for (auto state = slot.last_state; state != no_state; state = states_[state].previous_state) {
+            if (isSubset(reached_bits, reached_bits_.data() + states_[state].offset, num_words)) {
+                return false;
+            }
+        }
+        if (slot.last_state == no_state) {
+            slot.key = key;
+            ++num_keys_;
+        }
+        states_.push_back(State{reached_bits_.size(), slot.last_state});
+        slot.last_state = states_.size() - 1;
+        reached_bits_.insert(reached_bits_.end(), reached_bits, reached_bits + num_words);
+        if (2 * num_keys_ > slots_.size()) {
+            grow();
+        }
+        return true;
+    }
+
+    size_t getMemoryBytes() const noexcept {
+        return slots_.capacity() * sizeof(Slot) + states_.capacity() * sizeof(State) +
+               reached_bits_.capacity() * sizeof(WordType);
+    }
+
+    /// Memory of an inserted state, including the slots of the table which is at most half full.
+    static size_t getBytesPerState(size_t num_words) noexcept {
+        return sizeof(State) + num_words * sizeof(WordType) + 2 * sizeof(Slot);
+    }
+
+private:
+    static constexpr size_t no_state = std::numeric_limits<size_t>::max();
+    static constexpr size_t initial_capacity = 1024;
+
+    struct State {
+        // offset of the reached cells in reached_bits_
+        size_t offset;
+        // previously inserted state with the same key, or no_state
+        size_t previous_state;
+    };
+
+    // The states with equal keys are linked in reverse order of insertion. Empty slots have no state.
+    struct Slot {
+        StateKey key{};
+        size_t last_state{no_state};
+    };
+
+    /// Returns the slot of the given key, or the empty slot where it would be inserted (linear probing).
+    /// The keys are Zobrist hashes, so that their lower bits can be used as index directly. Keys with equal hashes and
+    /// different verification hashes occupy separate slots.
+    Slot& findSlot(const StateKey& key) noexcept {
+        const size_t mask = slots_.size() - 1;
+        for (size_t index = key.hash & mask;; index = (index + 1) & mask) {
+            if (slots_[index].last_state == no_state || slots_[index].key == key) {
+                return slots_[index];
+            }
+        }
+    }
+
+    void grow() {
+        std::vector<Slot> old_slots(2 * slots_.size());
+        std::swap(old_slots, slots_);
+        for (const Slot& slot : old_slots) {
+            if (slot.last_state != no_state) {
+                findSlot(slot.key) = slot;
+            }
+        }
+    }
+
+    static bool isSubset(const WordType* subset, const WordType* superset, size_t num_words) noexcept {
+        for (size_t i = 0; i < num_words; ++i) {
+            if ((subset[i] & ~superset[i]) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // open addressing hash table with a power of two number of slots, at most half of them occupied
+    std::vector<Slot> slots_;
+    size_t num_keys_{0};
+    std::vector<State> states_;
+    std::vector<WordType> reached_bits_;
+};
+
+StateKey stateKey(zobrist::HashType graph_hash,
+                  zobrist::HashType graph_verification_hash,
+                  const Location& previous_shift_location) {
+    const zobrist::HashType shift_key = zobrist::previousShiftKey(previous_shift_location);
+    return StateKey{graph_hash ^ shift_key, graph_verification_hash ^ zobrist::verificationKey(shift_key)};
+}
+
+/// Returns the cell of the objective after a shift, or CellLayout::no_cell if the objective has been pushed out.
+/// The objective cell before the shift is CellLayout::no_cell if the objective is the leftover.
+CellIndex shiftedObjectiveCell(CellIndex objective_cell, CellIndex shift_cell, const CellLayout& layout) {
+    if (objective_cell == CellLayout::no_cell) {
+        return shift_cell;
+    }
+    // The pushed-out cell is the only one which is translated to the shift cell.
+    const CellIndex shifted_cell = layout.translateByShift(objective_cell, shift_cell);
+    return shifted_cell == shift_cell ? CellLayout::no_cell : shifted_cell;
+}
+
+/// Returns the shifts which lead to the child of the given state with the given shift.
+std::vector<ShiftAction> shiftsToChild(const StateTree& tree, StateIndex parent_index, const ShiftAction& last_shift) {
+    std::vector<ShiftAction> shifts{last_shift};
+    for (auto cur = parent_index; !tree.getState(cur).isRoot(); cur = tree.getState(cur).parent) {
+        shifts.push_back(tree.getState(cur).shift);
+    }
+    std::reverse(shifts.begin(), shifts.end());
+    return shifts;
+}
+
+/// Reconstructs the player actions which lead to the objective cell after the given shifts.
+/// The reachable nodes of the states do not record their sources. Therefore, the reachable nodes are computed
+/// again along the shifts, together with their sources, cf. reachable::multiSourceReachableCells().
+/// All search modes use this reconstruction, so that they return the same moves for the same shifts.
+std::vector<PlayerAction> reconstructActions(const MazeGraph& base_graph,
+                                             const CellIndex player_cell,
+                                             const std::vector<ShiftAction>& shifts,
+                                             CellIndex objective_cell) {
     MazeGraph graph{base_graph};
-    std::vector<ShiftAction> shifts;
-    auto cur = current_state;
-    while (!cur->isRoot()) {
-        shifts.push_back(cur->shift);
-        cur = cur->parent;
-    }
-    for (auto shift = shifts.rbegin(); shift != shifts.rend(); ++shift) {
-        graph.shift(shift->location, shift->rotation);
-    }
-    return graph;
-}
-
-std::vector<Location> determineReachedLocations(const GameStateNode& current_state,
-                                                const MazeGraph& graph,
-                                                Location shift_location) {
-    std::vector<Location> updated_player_locations;
-    updated_player_locations.resize(current_state.reached_nodes.size());
-    std::transform(current_state.reached_nodes.begin(),
-                   current_state.reached_nodes.end(),
-                   updated_player_locations.begin(),
-                   [&graph, &shift_location](reachable::ReachableNode reached_node) {
-                       const Location& reached_location = reached_node.reached_location;
-                       return translateLocationByShift(reached_location, shift_location, graph.getExtent());
-                   });
-    return updated_player_locations;
-}
-
-StatePtr createNewState(const MazeGraph& shifted_graph, const ShiftAction& shift, StatePtr current_state) {
-    auto updated_player_locations = determineReachedLocations(*current_state, shifted_graph, shift.location);
-    StatePtr new_state = std::make_shared<GameStateNode>(
-        current_state, shift, reachable::multiSourceReachableLocations(shifted_graph, updated_player_locations));
-    return new_state;
-}
-
-std::vector<PlayerAction> reconstructActions(StatePtr new_state, size_t reachable_index) {
-    auto cur = new_state;
-    auto index = reachable_index;
-    std::vector<PlayerAction> actions;
-    while (!cur->isRoot()) {
-        actions.push_back(PlayerAction{cur->shift, cur->reached_nodes[index].reached_location});
-        index = cur->reached_nodes[index].parent_source_index;
-        cur = cur->parent;
-    }
-    std::reverse(actions.begin(), actions.end());
+    const CellLayout& layout = graph.getLayout();
+    std::vector<std::vector<reachable::ReachableCell>> reached_nodes;
+    std::vector<CellIndex> sources{player_cell};
+    for (const ShiftAction& shift : shifts) {
+        graph.shift(shift.location, shift.rotation);
+        const CellIndex shift_cell = layout.toCellIndex(shift.location);
+        std::transform(sources.begin(), sources.end(), sources.begin(), [&layout, shift_cell](CellIndex source) {
+            return layout.translateByShift(source, shift_cell);
+        });
+        reached_nodes.push_back(reachable::multiSourceReachableCells(graph, sources));
+        sources.clear();
+        std::transform(reached_nodes.back().begin(),
+                       reached_nodes.back().end(),
+                       std::back_inserter(sources),
+                       [](reachable::ReachableCell reached_node) { return reached_node.reached_cell; });
+    }
+    std::vector<PlayerAction> actions(shifts.size());
+    CellIndex move_cell = objective_cell;
+    for (size_t depth = shifts.size(); depth-- > 0;) {
+        const auto& reached = reached_nodes[depth];
+        const auto found = std::find_if(reached.begin(), reached.end(), [move_cell](const auto& reached_node) {
+            return reached_node.reached_cell == move_cell;
+        });
+        actions[depth] = PlayerAction{shifts[depth], layout.toLocation(move_cell)};
+        if (depth > 0) {
+            move_cell = reached_nodes[depth - 1][found->parent_source_index].reached_cell;
+        }
+    }
     return actions;
 }
 
-OutPaths combineOutPaths(OutPaths out_paths1, OutPaths out_paths2) {
-    return static_cast<OutPaths>(static_cast<OutPathsIntegerType>(out_paths1) |
-                                 static_cast<OutPathsIntegerType>(out_paths2));
+/// Returns the cell of the objective, or CellLayout::no_cell if the objective is the leftover.
+CellIndex objectiveCell(const MazeGraph& graph, NodeId objective_id) {
+    const auto objective_location = graph.getLocation(objective_id, Location{-1, -1});
+    return objective_location == Location{-1, -1} ? CellLayout::no_cell
+                                                   : graph.getLayout().toCellIndex(objective_location);
 }
 
-std::vector<RotationDegreeType> determineRotations(const Node& node) {
-    auto north_south = combineOutPaths(OutPaths::North, OutPaths::South);
-    auto east_west = combineOutPaths(OutPaths::East, OutPaths::West);
-    if (node.out_paths == north_south || node.out_paths == east_west) {
-        return std::vector<RotationDegreeType>{RotationDegreeType::_0, RotationDegreeType::_90};
-    } else {
-        return std::vector<RotationDegreeType>{
-            RotationDegreeType::_0, RotationDegreeType::_90, RotationDegreeType::_180, RotationDegreeType::_270};
+/// Plan to the game state which is closest to the objective so far, cf. SearchOptions::return_partial_plan.
+struct PartialPlan {
+    static constexpr size_t no_distance = std::numeric_limits<size_t>::max();
+
+    bool isEmpty() const noexcept { return distance == no_distance; }
+
+    size_t distance{no_distance};
+    std::vector<ShiftAction> shifts;
+    // reached cell of the last state which is closest to the objective
+    CellIndex closest_cell{CellLayout::no_cell};
+};
+
+/// Measures how close the reached cells of a game state are to the objective, cf. PartialPlan.
+///
+/// The distance of a state is the least Manhattan distance between one of its reached cells and the objective, as for
+/// reachable::closestReachableCell(). It ignores the walls, so that it only costs a pass over the reached cells.
+/// Only the move of the returned plan takes the walls into account, cf. moveClosestToObjective().
+/// If the objective has been pushed out, it will be inserted at one of the shift locations, so that the least
+/// distance to any of them is taken instead.
+class ClosenessMetric {
+public:
+    explicit ClosenessMetric(const MazeGraph& graph) {
+        const CellLayout& layout = graph.getLayout();
+        const size_t num_cells = layout.getNumberOfCells();
+        for (size_t cell = 0; cell < num_cells; ++cell) {
+            locations_.push_back(layout.toLocation(static_cast<CellIndex>(cell)));
+        }
+        shift_cell_distances_.assign(num_cells, PartialPlan::no_distance);
+        for (const Location& shift_location : graph.getShiftLocations()) {
+            for (size_t cell = 0; cell < num_cells; ++cell) {
+                shift_cell_distances_[cell] = std::min(shift_cell_distances_[cell],
+                                                       distance(locations_[cell], shift_location));
+            }
+        }
+    }
+
+    /// Updates the plan if the given state is closer to the objective. The objective cell is CellLayout::no_cell if the
+    /// objective has been pushed out. Returns if the plan has been updated, the shifts of the plan are left to the
+    /// caller.
+    bool update(PartialPlan& plan, const WordType* reached_bits, size_t num_words, CellIndex objective_cell) const {
+        bool is_updated = false;
+        for (size_t word_index = 0; word_index < num_words; ++word_index) {
+            for (WordType word = reached_bits[word_index]; word != 0; word &= word - 1) {
+                const auto cell = static_cast<CellIndex>(word_index * 64 + BitBoard::countTrailingZeros(word));
+                const size_t cell_distance = objective_cell == CellLayout::no_cell
+                                                 ? shift_cell_distances_[cell]
+                                                 : distance(locations_[cell], locations_[objective_cell]);
+                if (cell_distance < plan.distance) {
+                    plan.distance = cell_distance;
+                    plan.closest_cell = cell;
+                    is_updated = true;
+                }
+            }
+        }
+        return is_updated;
+    }
+
+private:
+    static size_t distance(const Location& location1, const Location& location2) noexcept {
+        return static_cast<size_t>(std::abs(location1.getRow() - location2.getRow()) +
+                                   std::abs(location1.getColumn() - location2.getColumn()));
     }
+
+    std::vector<Location> locations_;
+    // for each cell, the least distance to a shift location
+    std::vector<size_t> shift_cell_distances_;
+};
+
+/// Children of a contiguous range of states of one level, cf. LevelExpander.
+struct ExpandedChunk {
+    struct Child {
+        StateIndex parent;
+        ShiftAction shift;
+        // key of the state in the ClosedSet, only computed if duplicates are eliminated
+        StateKey key;
+    };
+
+    void clear() noexcept {
+        children.clear();
+        reached_bits.clear();
+        objective_cell = CellLayout::no_cell;
+    }
+
+    bool hasReachedObjective() const noexcept { return objective_cell != CellLayout::no_cell; }
+
+    // children which do not reach the objective, in the order of the breadth-first search
+    std::vector<Child> children;
+    std::vector<WordType> reached_bits;
+    // first child which reaches the objective, if any. The chunk ends with it.
+    Child objective_child{};
+    CellIndex objective_cell{CellLayout::no_cell};
+};
+
+/// Expands ranges of states of a StateTree. Each thread of the search uses its own expander, with its own maze and
+/// buffers. The tree is only read while states are expanded.
+class LevelExpander {
+public:
+    explicit LevelExpander(const MazeGraph& base_graph,
+                           NodeId objective_id,
+                           bool eliminate_duplicates,
+                           bool track_partial_plan) :
+        tree_graph_{base_graph},
+        objective_id_{objective_id},
+        eliminate_duplicates_{eliminate_duplicates},
+        track_partial_plan_{track_partial_plan},
+        closeness_{base_graph} {}
+
+    const SearchStatistics& getStatistics() const noexcept { return statistics_; }
+
+    /// Returns the plan to the closest child of the expanded states, if the partial plan is tracked.
+    const PartialPlan& getPartialPlan() const noexcept { return partial_plan_; }
+
+    /// Returns the parent of the closest child, which orders plans of equal distance like the breadth-first search.
+    StateIndex getPartialPlanParent() const noexcept { return partial_plan_parent_; }
+
+    void expand(const StateTree& tree, StateIndex first_state, StateIndex end_state, ExpandedChunk& chunk) {
+        chunk.clear();
+        for (StateIndex current_index = first_state; current_index < end_state && !is_aborted; ++current_index) {
+            if (expandState(tree, current_index, chunk)) {
+                return;
+            }
+        }
+    }
+
+private:
+    /// Adds the children of the given state to the chunk. Returns true if one of them reaches the objective.
+    bool expandState(const StateTree& tree, StateIndex current_index, ExpandedChunk& chunk) {
+        tree_graph_.moveTo(tree, current_index);
+        const MazeGraph& current_graph = tree_graph_.getGraph();
+        const CellLayout& layout = current_graph.getLayout();
+        const CellIndex objective_cell = objectiveCell(current_graph, objective_id_);
+        collectPlayerCells(tree, current_index, player_cells_);
+        children_.compute(current_graph, player_cells_, tree.getState(current_index).shift.location);
+        ++statistics_.expanded_states;
+        statistics_.generated_states += children_.getNumberOfChildren();
+        std::array<zobrist::HashType, 4> child_hashes{};
+        std::array<zobrist::HashType, 4> child_verification_hashes{};
+        for (size_t child_index = 0; child_index < children_.getNumberOfChildren(); ++child_index) {
+            const auto& child = children_.getChild(child_index);
+            const ShiftAction shift_action{child.shift_location, child.rotation};
+            const CellIndex shifted_objective_cell =
+                shiftedObjectiveCell(objective_cell, layout.toCellIndex(child.shift_location), layout);
+            if (shifted_objective_cell != CellLayout::no_cell &&
+                children_.isReached(child_index, shifted_objective_cell)) {
+                chunk.objective_child = ExpandedChunk::Child{current_index, shift_action, 0};
+                chunk.objective_cell = shifted_objective_cell;
+                return true;
+            }
+            if (track_partial_plan_ && closeness_.update(partial_plan_,
+                                                         children_.getReachedBits(child_index),
+                                                         children_.getNumberOfWords(),
+                                                         shifted_objective_cell)) {
+                partial_plan_.shifts = shiftsToChild(tree, current_index, shift_action);
+                partial_plan_parent_ = current_index;
+            }
+            StateKey key{};
+            if (eliminate_duplicates_) {
+                if (child_index == 0 || child.shift_location != children_.getChild(child_index - 1).shift_location) {
+                    child_hashes = current_graph.hashesAfterShift(child.shift_location);
+                    child_verification_hashes = current_graph.verificationHashesAfterShift(child.shift_location);
+                }
+                const auto rotation_index = static_cast<RotationDegreeIntegerType>(child.rotation);
+                key = stateKey(child_hashes[rotation_index],
+                               child_verification_hashes[rotation_index],
+                               child.shift_location);
+            }
+            chunk.children.push_back(ExpandedChunk::Child{current_index, shift_action, key});
+            const WordType* reached_bits = children_.getReachedBits(child_index);
+            chunk.reached_bits.insert(
+                chunk.reached_bits.end(), reached_bits, reached_bits + children_.getNumberOfWords());
+        }
+        return false;
+    }
+
+    TreeGraph tree_graph_;
+    NodeId objective_id_;
+    bool eliminate_duplicates_;
+    bool track_partial_plan_;
+    ClosenessMetric closeness_;
+    reachable::ChildrenReachability children_;
+    std::vector<CellIndex> player_cells_;
+    SearchStatistics statistics_;
+    PartialPlan partial_plan_;
+    StateIndex partial_plan_parent_{0};
+};
+
+/// Returns the number of threads which expand the states, cf. SearchOptions::num_threads.
+size_t numberOfThreads(const SearchOptions& options) {
+#ifdef __EMSCRIPTEN__
+    // WebAssembly modules are built without thread support.
+    static_cast<void>(options);
+    return 1;
+#else
+    if (options.num_threads == 0) {
+        return std::max(size_t{1}, static_cast<size_t>(std::thread::hardware_concurrency()));
+    }
+    return options.num_threads;
+#endif
 }
 
-MazeGraph shiftedGraph(const MazeGraph& base_graph, const ShiftAction& shift_action) {
+/// Runs a task on a fixed number of threads, which are started once and kept alive for all levels of a search.
+/// The calling thread takes part as the thread with index 0.
+class WorkerPool {
+public:
+    explicit WorkerPool(size_t num_threads) {
+#ifdef __EMSCRIPTEN__
+        static_cast<void>(num_threads);
+#else
+        for (size_t thread_index = 1; thread_index < num_threads; ++thread_index) {
+            workers_.emplace_back([this, thread_index]() { work(thread_index); });
+        }
+#endif
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    ~WorkerPool() {
+#ifndef __EMSCRIPTEN__
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            is_stopped_ = true;
+        }
+        task_started_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+#endif
+    }
+
+    /// Calls the task with the index of each thread, and returns once all calls have returned.
+    void run(const std::function<void(size_t)>& task) {
+#ifdef __EMSCRIPTEN__
+        task(0);
+#else
+        if (workers_.empty()) {
+            task(0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            task_ = task;
+            num_running_ = workers_.size();
+            ++generation_;
+        }
+        task_started_.notify_all();
+        task(0);
+        std::unique_lock<std::mutex> lock{mutex_};
+        task_finished_.wait(lock, [this]() { return num_running_ == 0; });
+#endif
+    }
+
+private:
+#ifndef __EMSCRIPTEN__
+    void work(size_t thread_index) {
+        size_t generation = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock{mutex_};
+                task_started_.wait(lock, [this, generation]() { return is_stopped_ || generation_ != generation; });
+                if (is_stopped_) {
+                    return;
+                }
+                generation = generation_;
+            }
+            // The task is only replaced after all threads have finished it.
+            task_(thread_index);
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (--num_running_ == 0) {
+                task_finished_.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable task_started_;
+    std::condition_variable task_finished_;
+    std::function<void(size_t)> task_;
+    size_t generation_{0};
+    size_t num_running_{0};
+    bool is_stopped_{false};
+#endif
+};
+
+void addStatistics(SearchStatistics& sum, const SearchStatistics& statistics) noexcept {
+    sum.expanded_states += statistics.expanded_states;
+    sum.generated_states += statistics.generated_states;
+    sum.pruned_states += statistics.pruned_states;
+}
+
+/// Returns the closest of the partial plans of the expanders. Of equally close plans, the first one in breadth-first
+/// order is returned, so that the result does not depend on the number of threads.
+PartialPlan closestPartialPlan(const std::vector<LevelExpander>& expanders) {
+    auto closest = expanders.begin();
+    for (auto expander = expanders.begin() + 1; expander != expanders.end(); ++expander) {
+        const size_t distance = expander->getPartialPlan().distance;
+        if (distance < closest->getPartialPlan().distance ||
+            (distance == closest->getPartialPlan().distance &&
+             expander->getPartialPlanParent() < closest->getPartialPlanParent())) {
+            closest = expander;
+        }
+    }
+    return closest->getPartialPlan();
+}
+
+/// Replaces the last move of a partial plan by the cell which reachable::closestReachableCell() returns for the source
+/// of the last move. The distance of the plan is kept, as the previous move cell is one of the closest reachable cells,
+/// but of the equally close cells, the player moves to the one with the shortest path.
+/// The move is kept if the objective has been pushed out by the last shift.
+void moveClosestToObjective(const MazeGraph& base_graph,
+                            NodeId objective_id,
+                            CellIndex player_cell,
+                            const std::vector<ShiftAction>& shifts,
+                            std::vector<PlayerAction>& actions) {
     MazeGraph graph{base_graph};
-    graph.shift(shift_action.location, shift_action.rotation);
-    return graph;
+    for (const ShiftAction& shift : shifts) {
+        graph.shift(shift.location, shift.rotation);
+    }
+    const CellIndex objective_cell = objectiveCell(graph, objective_id);
+    if (objective_cell == CellLayout::no_cell) {
+        return;
+    }
+    const CellLayout& layout = graph.getLayout();
+    const CellIndex previous_cell =
+        actions.size() > 1 ? layout.toCellIndex(actions[actions.size() - 2].move_location) : player_cell;
+    const CellIndex source = layout.translateByShift(previous_cell, layout.toCellIndex(shifts.back().location));
+    actions.back().move_location = layout.toLocation(reachable::closestReachableCell(graph, source, objective_cell));
+}
+
+/// Returns the result of an aborted search, which consists of the given partial plan, if any.
+SearchResult partialResult(const MazeGraph& base_graph,
+                           NodeId objective_id,
+                           CellIndex player_cell,
+                           const PartialPlan& partial_plan,
+                           const SearchStatistics& statistics,
+                           SearchMode mode) {
+    if (partial_plan.isEmpty()) {
+        return SearchResult{std::vector<PlayerAction>{}, statistics, mode};
+    }
+    std::vector<PlayerAction> actions =
+        reconstructActions(base_graph, player_cell, partial_plan.shifts, partial_plan.closest_cell);
+    moveClosestToObjective(base_graph, objective_id, player_cell, partial_plan.shifts, actions);
+    return SearchResult{std::move(actions), statistics, mode, true};
+}
+
+SearchStatistics sumStatistics(const std::vector<LevelExpander>& expanders) {
+    SearchStatistics sum;
+    for (const auto& expander : expanders) {
+        addStatistics(sum, expander.getStatistics());
+    }
+    return sum;
+}
+
+/// Admissible lower bound on the number of turns which are required to reach the objective, cf. SearchMode::informed.
+///
+/// A shift only changes the tiles of the shifted line, and only moves cells along this line. Hence, if the objective
+/// is reachable after a shift, it is also reachable in the maze where all cells of the shifted line are open in all
+/// directions: each connection of the shifted maze also exists in this relaxed maze, and the player cells and the
+/// objective only move within the line, which is connected as a whole. The same holds for two turns, when the cells
+/// of both shifted lines are opened: the player reaches its location after the first turn, and the objective, in
+/// the relaxed maze. However, if the objective lies in the first line, the first shift may push it out, and the second
+/// shift may insert it into the second line, which is not connected to the first one if they are parallel. Hence, the
+/// whole other line is a target as well if one of the lines contains the objective.
+/// If the objective is not reachable in the relaxed maze of any line, or of any pair of lines, at least two or three
+/// turns are required, respectively. The relaxed mazes are flood-filled as MazeBitBoards. For larger mazes, and for
+/// more turns, no bound is computed.
+class TurnLowerBound {
+public:
+    static constexpr size_t max_turns = 2;
+
+    explicit TurnLowerBound(const MazeGraph& graph) {
+        const auto extent = graph.getExtent();
+        if (!MazeBitBoard::supportsExtent(extent)) {
+            return;
+        }
+        const CellLayout& layout = graph.getLayout();
+        for (const Location& shift_location : graph.getShiftLocations()) {
+            const bool is_column =
+                shift_location.getRow() == 0 || shift_location.getRow() == static_cast<Location::IndexType>(extent - 1);
+            BitBoard line;
+            for (auto position = 0; position < extent; ++position) {
+                line.set(layout.toCellIndex(is_column ? Location{position, shift_location.getColumn()}
+                                                      : Location{shift_location.getRow(), position}));
+            }
+            if (std::find(lines_.begin(), lines_.end(), line) == lines_.end()) {
+                lines_.push_back(line);
+            }
+        }
+    }
+
+    /// Returns false if the objective can certainly not be reached from the player cells within the given number of
+    /// turns. The objective cell is CellLayout::no_cell if the objective is the leftover.
+    bool mayReachWithin(size_t num_turns,
+                        const MazeGraph& graph,
+                        const std::vector<CellIndex>& player_cells,
+                        CellIndex objective_cell) const {
+        if (lines_.empty() || num_turns > max_turns) {
+            return true;
+        }
+        const MazeBitBoard board{graph};
+        BitBoard players;
+        for (CellIndex player_cell : player_cells) {
+            players.set(player_cell);
+        }
+        for (auto first_line = lines_.begin(); first_line != lines_.end(); ++first_line) {
+            // For a single turn, the second line equals the first one.
+            const auto end_second_line = num_turns == 1 ? first_line + 1 : lines_.end();
+            for (auto second_line = first_line; second_line != end_second_line; ++second_line) {
+                const BitBoard open_cells = *first_line | *second_line;
+                MazeBitBoard relaxed_board{board};
+                relaxed_board.openCells(open_cells);
+                // The leftover is inserted into one of the lines.
+                BitBoard objective = open_cells;
+                if (objective_cell != CellLayout::no_cell) {
+                    objective = BitBoard::singleBit(objective_cell);
+                    if (num_turns == 2 && first_line->test(objective_cell)) {
+                        objective |= *second_line;
+                    }
+                    if (num_turns == 2 && second_line->test(objective_cell)) {
+                        objective |= *first_line;
+                    }
+                }
+                if ((relaxed_board.floodFill(players) & objective).any()) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    // cells of each shiftable line
+    std::vector<BitBoard> lines_;
+};
+
+/// Depth-first search with increasing depth limits, which shifts a single maze in place.
+///
+/// Only the states on the current path are stored, one frame per depth. Each frame holds the children of its state,
+/// and the index of the child which is currently searched. The sources of a frame are the reached cells of the
+/// current child of the previous frame.
+/// As the children are searched in the same order as they are queued by the breadth-first search, both return the
+/// same actions.
+/// Optionally, states are skipped if the objective cannot be reached from them within the depth limit, according to
+/// a TurnLowerBound. This also does not change the result, as only states without a path to the objective within the
+/// depth limit are skipped.
+class IterativeDeepeningSearch {
+public:
+    explicit IterativeDeepeningSearch(const SolverInstance& solver_instance,
+                                      bool use_lower_bound,
+                                      bool track_partial_plan) :
+        graph_{solver_instance.graph},
+        objective_id_{solver_instance.objective_id},
+        player_cell_{graph_.getLayout().toCellIndex(solver_instance.player_location)},
+        previous_shift_location_{solver_instance.previous_shift_location},
+        lower_bound_{graph_},
+        use_lower_bound_{use_lower_bound},
+        track_partial_plan_{track_partial_plan},
+        closeness_{graph_} {}
+
+    /// Continues with the partial plan of a previous search, which is replaced by closer states only.
+    void setPartialPlan(PartialPlan partial_plan) { partial_plan_ = std::move(partial_plan); }
+
+    /// Searches with increasing depth limits, starting with the given one. Lower depths must not contain the objective.
+    SearchResult run(size_t first_depth_limit = 1) {
+        const SearchMode mode = use_lower_bound_ ? SearchMode::informed : SearchMode::iterative_deepening;
+        for (size_t depth_limit = first_depth_limit; !is_aborted; ++depth_limit) {
+            frames_.resize(depth_limit);
+            frames_[0].player_cells.assign(1, player_cell_);
+            if (search(0, previous_shift_location_, depth_limit)) {
+                return SearchResult{reconstructActions(graph_, player_cell_, pathShifts(depth_limit), objective_cell_),
+                                    statistics_,
+                                    mode};
+            }
+        }
+        if (track_partial_plan_) {
+            return partialResult(graph_, objective_id_, player_cell_, partial_plan_, statistics_, mode);
+        }
+        return SearchResult{std::vector<PlayerAction>{}, statistics_, mode};
+    }
+
+private:
+    struct Frame {
+        reachable::ChildrenReachability children;
+        std::vector<CellIndex> player_cells;
+        size_t child_index{0};
+    };
+
+    /// Searches the children of the current maze, which is the state of the frame with the given depth.
+    /// Returns true if the objective has been reached. The path to it is then given by the child indices of the frames,
+    /// and by objective_cell_.
+    bool search(size_t depth, const Location& previous_shift_location, size_t depth_limit) {
+        Frame& frame = frames_[depth];
+        const size_t remaining_turns = depth_limit - depth;
+        if (use_lower_bound_ && remaining_turns <= TurnLowerBound::max_turns &&
+            !lower_bound_.mayReachWithin(
+                remaining_turns, graph_, frame.player_cells, objectiveCell(graph_, objective_id_))) {
+            ++statistics_.pruned_states;
+            return false;
+        }
+        frame.children.compute(graph_, frame.player_cells, previous_shift_location);
+        ++statistics_.expanded_states;
+        statistics_.generated_states += frame.children.getNumberOfChildren();
+        if (track_partial_plan_) {
+            updatePartialPlan(depth);
+        }
+        const auto& children = frame.children;
+        if (remaining_turns == 1) {
+            // Objectives at lower depths have already been searched for with lower depth limits.
+            return findObjective(frame);
+        }
+        Frame& next_frame = frames_[depth + 1];
+        for (size_t child_index = 0; child_index < children.getNumberOfChildren() && !is_aborted; ++child_index) {
+            const auto& child = children.getChild(child_index);
+            frame.child_index = child_index;
+            next_frame.player_cells.clear();
+            std::transform(children.reachedCellsBegin(child_index),
+                           children.reachedCellsEnd(child_index),
+                           std::back_inserter(next_frame.player_cells),
+                           [](reachable::ReachableCell reached_node) { return reached_node.reached_cell; });
+            const auto undo_record = graph_.applyShift(child.shift_location, child.rotation);
+            const bool has_reached_objective = search(depth + 1, child.shift_location, depth_limit);
+            graph_.undo(undo_record);
+            if (has_reached_objective) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Checks if one of the children of the given frame reaches the objective, and selects the first one which does.
+    bool findObjective(Frame& frame) {
+        const auto& children = frame.children;
+        const CellLayout& layout = graph_.getLayout();
+        const CellIndex objective_cell = objectiveCell(graph_, objective_id_);
+        for (size_t child_index = 0; child_index < children.getNumberOfChildren(); ++child_index) {
+            const auto& child = children.getChild(child_index);
+            const CellIndex shifted_objective_cell =
+                shiftedObjectiveCell(objective_cell, layout.toCellIndex(child.shift_location), layout);
+            if (shifted_objective_cell != CellLayout::no_cell &&
+                children.isReached(child_index, shifted_objective_cell)) {
+                frame.child_index = child_index;
+                objective_cell_ = shifted_objective_cell;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Replaces the partial plan by the closest child of the frame with the given depth, if it is closer.
+    void updatePartialPlan(size_t depth) {
+        Frame& frame = frames_[depth];
+        const auto& children = frame.children;
+        const CellLayout& layout = graph_.getLayout();
+        const CellIndex objective_cell = objectiveCell(graph_, objective_id_);
+        for (size_t child_index = 0; child_index < children.getNumberOfChildren(); ++child_index) {
+            const CellIndex shifted_objective_cell = shiftedObjectiveCell(
+                objective_cell, layout.toCellIndex(children.getChild(child_index).shift_location), layout);
+            if (closeness_.update(partial_plan_,
+                                  children.getReachedBits(child_index),
+                                  children.getNumberOfWords(),
+                                  shifted_objective_cell)) {
+                frame.child_index = child_index;
+                partial_plan_.shifts = pathShifts(depth + 1);
+            }
+        }
+    }
+
+    /// Returns the shifts to the state of the last frame, and to its selected child.
+    std::vector<ShiftAction> pathShifts(size_t depth_limit) const {
+        std::vector<ShiftAction> shifts;
+        for (size_t depth = 0; depth < depth_limit; ++depth) {
+            const Frame& frame = frames_[depth];
+            const auto& child = frame.children.getChild(frame.child_index);
+            shifts.push_back(ShiftAction{child.shift_location, child.rotation});
+        }
+        return shifts;
+    }
+
+    MazeGraph graph_;
+    NodeId objective_id_;
+    CellIndex player_cell_;
+    Location previous_shift_location_;
+    TurnLowerBound lower_bound_;
+    bool use_lower_bound_;
+    bool track_partial_plan_;
+    ClosenessMetric closeness_;
+    PartialPlan partial_plan_;
+    std::vector<Frame> frames_;
+    // cell of the objective in the selected child of the last frame
+    CellIndex objective_cell_{CellLayout::no_cell};
+    SearchStatistics statistics_;
+};
+
+/// Estimates the memory of the breadth-first search while it expands the given number of states of the next level,
+/// in bytes. The number of children per state is the average of the levels so far, i.e. the estimate requires at least
+/// one expanded state. The children are held in chunks, and then appended to the tree. The tree is reserved for them
+/// at once, so that its previous buffers coexist with the new ones while the children are appended.
+size_t estimatedPeakMemory(const StateTree& tree,
+                           const ClosedSet& closed_set,
+                           const SearchOptions& options,
+                           const SearchStatistics& statistics,
+                           size_t num_level_states) {
+    const size_t children_per_state =
+        (statistics.generated_states + statistics.expanded_states - 1) / statistics.expanded_states;
+    const size_t num_children = num_level_states * children_per_state;
+    const size_t num_words = tree.getNumberOfWords();
+    const size_t chunk_bytes = num_children * (sizeof(ExpandedChunk::Child) + num_words * sizeof(WordType));
+    const size_t tree_bytes = 2 * tree.getMemoryBytes() + num_children * tree.getBytesPerState();
+    size_t closed_set_bytes = 0;
+    if (options.eliminate_duplicates) {
+        closed_set_bytes = closed_set.getMemoryBytes() + num_children * ClosedSet::getBytesPerState(num_words);
+    }
+    return chunk_bytes + tree_bytes + closed_set_bytes;
+}
+
+/// Breadth-first search, which expands the game states level by level.
+///
+/// The states of a level are divided into chunks of consecutive states, which are expanded by the threads of the
+/// search in parallel. Each thread takes the next unexpanded chunk, until all of them have been expanded. The threads
+/// are started once, and wait for the next level in between, cf. WorkerPool.
+/// Afterwards, the children are appended to the tree chunk by chunk, i.e. in the same order as a sequential search
+/// would create them. If children reach the objective, the first of them in this order is returned. Therefore, the
+/// result does not depend on the number of threads.
+///
+/// If expanding the next level would exceed the memory limit of the options, all states are released, and the search
+/// continues with an iterative deepening search from the depth of the next level. It returns the same actions as the
+/// breadth-first search would have, cf. SearchMode::iterative_deepening.
+SearchResult breadthFirstSearch(const SolverInstance& solver_instance, const SearchOptions& options) {
+    // invariant: GameState contains reachable nodes after shift has been carried out.
+    constexpr StateIndex chunk_size = 16;
+    const CellLayout& layout = solver_instance.graph.getLayout();
+    StateTree tree{layout.getNumberOfCells()};
+    const CellIndex player_cell = layout.toCellIndex(solver_instance.player_location);
+    tree.addRoot(ShiftAction{solver_instance.previous_shift_location, RotationDegreeType::_0}, player_cell);
+    ClosedSet closed_set;
+    if (options.eliminate_duplicates) {
+        closed_set.insert(stateKey(solver_instance.graph.getHash(),
+                                   solver_instance.graph.getVerificationHash(),
+                                   solver_instance.previous_shift_location),
+                          tree.getReachedBits(0),
+                          tree.getNumberOfWords());
+    }
+    std::vector<LevelExpander> expanders(
+        numberOfThreads(options),
+        LevelExpander{solver_instance.graph,
+                      solver_instance.objective_id,
+                      options.eliminate_duplicates,
+                      options.return_partial_plan});
+    std::vector<ExpandedChunk> chunks;
+    WorkerPool workers{expanders.size()};
+    size_t depth = 0;
+    for (StateIndex level_begin = 0; level_begin < tree.size() && !is_aborted; ++depth) {
+        const auto level_end = static_cast<StateIndex>(tree.size());
+        // The root level is always expanded.
+        if (options.max_memory_bytes != 0 && depth > 0 &&
+            estimatedPeakMemory(tree, closed_set, options, sumStatistics(expanders), level_end - level_begin) >
+                options.max_memory_bytes) {
+            SearchStatistics statistics = sumStatistics(expanders);
+            tree = StateTree{0};
+            closed_set = ClosedSet{};
+            chunks = std::vector<ExpandedChunk>{};
+            IterativeDeepeningSearch search{solver_instance, false, options.return_partial_plan};
+            search.setPartialPlan(closestPartialPlan(expanders));
+            SearchResult result = search.run(depth + 1);
+            addStatistics(result.statistics, statistics);
+            return result;
+        }
+        const size_t num_chunks = (level_end - level_begin + chunk_size - 1) / chunk_size;
+        if (chunks.size() < num_chunks) {
+            chunks.resize(num_chunks);
+        }
+        std::atomic<size_t> next_chunk{0};
+        // Chunks after the first chunk which reaches the objective are not required.
+        std::atomic<size_t> first_objective_chunk{num_chunks};
+        workers.run([&](size_t thread_index) {
+            LevelExpander& expander = expanders[thread_index];
+            for (size_t chunk_index = next_chunk++; chunk_index < first_objective_chunk && !is_aborted;
+                 chunk_index = next_chunk++) {
+                const auto first_state = static_cast<StateIndex>(level_begin + chunk_index * chunk_size);
+                const auto end_state = std::min(static_cast<StateIndex>(first_state + chunk_size), level_end);
+                expander.expand(tree, first_state, end_state, chunks[chunk_index]);
+                if (chunks[chunk_index].hasReachedObjective()) {
+                    size_t previous = first_objective_chunk;
+                    while (chunk_index < previous &&
+                           !first_objective_chunk.compare_exchange_weak(previous, chunk_index)) {
+                    }
+                }
+            }
+        });
+        if (is_aborted) {
+            break;
+        }
+        if (first_objective_chunk < num_chunks) {
+            const ExpandedChunk& chunk = chunks[first_objective_chunk];
+            const auto shifts = shiftsToChild(tree, chunk.objective_child.parent, chunk.objective_child.shift);
+            return SearchResult{reconstructActions(solver_instance.graph, player_cell, shifts, chunk.objective_cell),
+                                sumStatistics(expanders),
+                                SearchMode::breadth_first};
+        }
+        const size_t num_words = tree.getNumberOfWords();
+        size_t num_children = 0;
+        for (size_t chunk_index = 0; chunk_index < num_chunks; ++chunk_index) {
+            num_children += chunks[chunk_index].children.size();
+        }
+        tree.reserve(tree.size() + num_children);
+        for (size_t chunk_index = 0; chunk_index < num_chunks; ++chunk_index) {
+            const ExpandedChunk& chunk = chunks[chunk_index];
+            for (size_t child_index = 0; child_index < chunk.children.size(); ++child_index) {
+                const auto& child = chunk.children[child_index];
+                const WordType* reached_bits = chunk.reached_bits.data() + child_index * num_words;
+                if (options.eliminate_duplicates && !closed_set.insert(child.key, reached_bits, num_words)) {
+                    continue;
+                }
+                tree.addChild(child.parent, child.shift, reached_bits);
+            }
+        }
+        level_begin = level_end;
+    }
+    if (options.return_partial_plan) {
+        return partialResult(solver_instance.graph,
+                             solver_instance.objective_id,
+                             player_cell,
+                             closestPartialPlan(expanders),
+                             sumStatistics(expanders),
+                             SearchMode::breadth_first);
+    }
+    return SearchResult{std::vector<PlayerAction>{}, sumStatistics(expanders), SearchMode::breadth_first};
 }
 
 } // anonymous namespace
@@ -126,45 +1086,17 @@ void abortComputation() {
 }
 
 std::vector<PlayerAction> findBestActions(const SolverInstance& solver_instance) {
-    // invariant: GameStateNode contains reachable nodes after shift has been carried out.
+    return findBestActionsWithOptions(solver_instance, SearchOptions{}).actions;
+}
+
+SearchResult findBestActionsWithOptions(const SolverInstance& solver_instance, const SearchOptions& options) {
     is_aborted = false;
-    auto objective_id = solver_instance.objective_id;
-    QueueType state_queue;
-    StatePtr root = std::make_shared<GameStateNode>();
-    root->reached_nodes.emplace_back(0, solver_instance.player_location);
-    root->shift = ShiftAction{solver_instance.previous_shift_location, RotationDegreeType::_0};
-    state_queue.push(root);
-    while (!state_queue.empty() && !is_aborted) {
-        auto current_state = state_queue.front();
-        state_queue.pop();
-        MazeGraph current_graph = createGraphFromState(solver_instance.graph, current_state);
-        auto shift_locations = current_graph.getShiftLocations();
-        auto invalid_shift_location = opposingShiftLocation(current_state->shift.location, current_graph.getExtent());
-        for (const auto& shift_location : shift_locations) {
-            if (shift_location == invalid_shift_location) {
-                continue;
-            }
-            auto rotations = determineRotations(current_graph.getLeftover());
-            for (RotationDegreeType rotation : rotations) {
-                const ShiftAction shift_action{shift_location, rotation};
-                const MazeGraph shifted_graph = shiftedGraph(current_graph, shift_action);
-                auto new_state = createNewState(shifted_graph, shift_action, current_state);
-                auto found_objective =
-                    std::find_if(new_state->reached_nodes.begin(),
-                                 new_state->reached_nodes.end(),
-                                 [objective_id, &shifted_graph](auto& reached_node) {
-                                     return shifted_graph.getNode(reached_node.reached_location).node_id == objective_id;
-                                 });
-                if (found_objective != new_state->reached_nodes.end()) {
-                    const size_t reachable_index = found_objective - new_state->reached_nodes.begin();
-                    return reconstructActions(new_state, reachable_index);
-                } else {
-                    state_queue.push(new_state);
-                }
-            }
-        }
+    if (options.mode == SearchMode::iterative_deepening || options.mode == SearchMode::informed) {
+        IterativeDeepeningSearch search{
+            solver_instance, options.mode == SearchMode::informed, options.return_partial_plan};
+        return search.run();
     }
-    return std::vector<PlayerAction>{};
+    return breadthFirstSearch(solver_instance, options);
 }
 
 } // namespace exhsearch
@@ -16,9 +16,80 @@ static std::atomic_bool is_aborted = false;
  */
 void abortComputation();
 
+enum class SearchMode {
+    /** Expands the game states level by level, and keeps all of them in memory. */
+    breadth_first,
+    /** Repeats a depth-first search with increasing depth limits, and only keeps the states of the current path.
+     * Each level is searched again for each larger depth limit, which costs a fraction of the next level.
+     * It returns the same actions as the breadth-first search without duplicate elimination.
+     */
+    iterative_deepening,
+    /** Same as iterative_deepening, but skips game states from which the objective cannot be reached within the depth
+     * limit, according to an admissible lower bound on the number of remaining turns. It returns the same actions.
+     */
+    informed
+};
+
+/** Options of the search, cf. findBestActionsWithOptions(). */
+struct SearchOptions {
+    SearchMode mode{SearchMode::breadth_first};
+
+    /** Drops states which reach a subset of the locations of an already queued state with the same maze and previous
+     * shift. As the leftover changes with each shift, such transpositions are rare, and the bookkeeping usually costs
+     * more than it saves. Therefore, it is disabled by default. Only applies to the breadth-first search.
+     */
+    bool eliminate_duplicates{false};
+
+    /** Number of threads which expand the game states of the breadth-first search, or 0 for one thread per core.
+     * The result does not depend on the number of threads. WebAssembly builds always use a single thread.
+     */
+    size_t num_threads{1};
+
+    /** Upper limit for the memory of the game states of the breadth-first search in bytes, or 0 for no limit.
+     * Before a level is expanded, its memory is estimated from the number of children per state so far. If the limit
+     * would be exceeded, the stored game states are released, and the search continues in iterative_deepening mode
+     * from the depth of this level. This returns the same actions, but searches the previous levels again. Cf.
+     * SearchResult::finished_mode.
+     */
+    size_t max_memory_bytes{0};
+
+    /** If the search is aborted before the objective has been reached, returns the actions which lead to the searched
+     * game state closest to the objective instead of no actions, cf. SearchResult::is_partial. The distance of a
+     * state is the least Manhattan distance between its reached locations and the objective. Of equally close states,
+     * the first one found is kept. Tracking the closest state costs a pass over the reached locations of each state.
+     * In the last action, the player moves to the closest location with the shortest path from its previous location.
+     */
+    bool return_partial_plan{false};
+};
+
+/** Counters of a search, e.g. to compare the search modes. */
+struct SearchStatistics {
+    /** number of game states whose children have been computed */
+    size_t expanded_states{0};
+    /** number of game states which have been created as children of expanded states */
+    size_t generated_states{0};
+    /** number of game states which have been skipped by the informed search */
+    size_t pruned_states{0};
+};
+
+struct SearchResult {
+    /** best actions, or empty if the search has been aborted without SearchOptions::return_partial_plan */
+    std::vector<PlayerAction> actions;
+    SearchStatistics statistics;
+    /** mode which has finished the search, i.e. iterative_deepening if the breadth-first search has exceeded its memory
+     * limit
+     */
+    SearchMode finished_mode{SearchMode::breadth_first};
+    /** true if the search has been aborted, and the actions do not reach the objective */
+    bool is_partial{false};
+};
+
 /** Searches for the lowest number of actions which lead to the objective. */
 std::vector<PlayerAction> findBestActions(const SolverInstance& solver_instance);
 
+/** Same as findBestActions(), with the given options. */
+SearchResult findBestActionsWithOptions(const SolverInstance& solver_instance, const SearchOptions& options);
+
 } // namespace exhsearch
 } // namespace solvers
 } // namespace labyrinth
@@ -1,78 +1,528 @@
 #include "graph_algorithms.h"
 
-#include <limits>
-#include <queue>
-#include <unordered_map>
+#include "bitboard.h"
+#include "row_masks.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
 
 namespace labyrinth {
 namespace reachable {
 
-bool isReachable(const MazeGraph& graph, const Location& source, const Location& target) {
-    std::queue<Location> q;
-    std::vector<bool> visited(graph.getNumberOfNodes(), false);
-    q.push(source);
-    while (!q.empty()) {
-        auto location = q.front();
-        if (location == target) {
+namespace { // anonymous namespace for file-internal linkage
+
+// Graph searches, which operate on cell indices and follow the connected edges of each cell.
+// They are used for single-target queries on mazes which are too large for a MazeBitBoard, for reachable sets of
+// mazes which are too large for a RowMaskBoard, and for all distance computations.
+
+template <typename Function>
+void forEachNeighborCell(const MazeGraph& graph, CellIndex cell, Function function) {
+    auto edges = static_cast<unsigned int>(graph.getConnectedEdges(cell));
+    while (edges != 0) {
+        const auto out_path = static_cast<OutPaths>(edges & (~edges + 1));
+        function(graph.neighborCell(cell, out_path));
+        edges &= edges - 1;
+    }
+}
+
+int manhattanDistance(const Location& location1, const Location& location2) {
+    return std::abs(location1.getRow() - location2.getRow()) + std::abs(location1.getColumn() - location2.getColumn());
+}
+
+bool isReachableForward(const MazeGraph& graph, CellIndex source, CellIndex target, BfsWorkspace& workspace) {
+    workspace.reset(graph.getLayout().getNumberOfCells());
+    workspace.push(source);
+    while (!workspace.isQueueEmpty()) {
+        const CellIndex cell = workspace.pop();
+        if (cell == target) {
+            return true;
+        }
+        forEachNeighborCell(graph, cell, [&workspace](CellIndex neighbor) {
+            if (!workspace.isVisited(neighbor)) {
+                workspace.push(neighbor);
+            }
+        });
+    }
+    return false;
+}
+
+bool isReachableBidirectional(const MazeGraph& graph, CellIndex source, CellIndex target, BfsWorkspace& workspace) {
+    // Both searches share the queue, so that they advance alternately layer by layer.
+    // The parent of a visited cell denotes the side it has been reached from.
+    constexpr CellIndex source_side = 0;
+    constexpr CellIndex target_side = 1;
+    workspace.reset(graph.getLayout().getNumberOfCells());
+    if (source == target) {
+        return true;
+    }
+    workspace.push(source);
+    workspace.setParent(source, source_side);
+    workspace.push(target);
+    workspace.setParent(target, target_side);
+    while (!workspace.isQueueEmpty()) {
+        const CellIndex cell = workspace.pop();
+        const CellIndex side = workspace.getParent(cell);
+        bool has_met = false;
+        forEachNeighborCell(graph, cell, [&workspace, &has_met, side](CellIndex neighbor) {
+            if (!workspace.isVisited(neighbor)) {
+                workspace.push(neighbor);
+                workspace.setParent(neighbor, side);
+            } else if (workspace.getParent(neighbor) != side) {
+                has_met = true;
+            }
+        });
+        if (has_met) {
             return true;
         }
-        q.pop();
-        visited[graph.getNode(location).node_id] = true;
-        for (auto neighbor_it = graph.neighbors(location); !neighbor_it.isAtEnd(); ++neighbor_it) {
-            if (!visited[graph.getNode(*neighbor_it).node_id]) {
-                q.push(*neighbor_it);
+    }
+    return false;
+}
+
+bool isReachableGoalDirected(const MazeGraph& graph, CellIndex source, CellIndex target, BfsWorkspace& workspace) {
+    const CellLayout& layout = graph.getLayout();
+    const Location target_location = layout.toLocation(target);
+    const auto distance_to_target = [&layout, &target_location](CellIndex cell) {
+        return manhattanDistance(layout.toLocation(cell), target_location);
+    };
+    workspace.reset(layout.getNumberOfCells());
+    workspace.push(source);
+    while (!workspace.isQueueEmpty()) {
+        const CellIndex cell = workspace.popLast();
+        if (cell == target) {
+            return true;
+        }
+        // The neighbor closest to the target is pushed last, and is therefore expanded next.
+        // There are at most four neighbors, so they are sorted by insertion.
+        std::array<CellIndex, 4> neighbors{};
+        std::array<int, 4> distances{};
+        size_t num_neighbors = 0;
+        forEachNeighborCell(graph, cell, [&](CellIndex neighbor) {
+            if (!workspace.isVisited(neighbor)) {
+                const int distance = distance_to_target(neighbor);
+                size_t position = num_neighbors++;
+                for (; position > 0 && distances[position - 1] < distance; --position) {
+                    neighbors[position] = neighbors[position - 1];
+                    distances[position] = distances[position - 1];
+                }
+                neighbors[position] = neighbor;
+                distances[position] = distance;
             }
+        });
+        for (size_t i = 0; i < num_neighbors; ++i) {
+            workspace.push(neighbors[i]);
         }
     }
     return false;
 }
 
-std::vector<Location> reachableLocations(const MazeGraph& graph, const Location& source) {
-    std::queue<Location> q;
-    std::vector<bool> visited(graph.getNumberOfNodes(), false);
-    q.push(source);
-    visited[graph.getNode(source).node_id] = true;
-    std::vector<Location> result;
-    result.reserve(graph.getNumberOfNodes());
-    while (!q.empty()) {
-        auto location = q.front();
-        result.push_back(location);
-        q.pop();
-        visited[graph.getNode(location).node_id] = true;
-        for (auto neighbor_it = graph.neighbors(location); !neighbor_it.isAtEnd(); ++neighbor_it) {
-            if (!visited[graph.getNode(*neighbor_it).node_id]) {
-                q.push(*neighbor_it);
+void reachableCellsBfs(const MazeGraph& graph, CellIndex source, BfsWorkspace& workspace) {
+    auto& result = workspace.cellsBuffer();
+    workspace.push(source);
+    while (!workspace.isQueueEmpty()) {
+        const CellIndex cell = workspace.pop();
+        result.push_back(cell);
+        forEachNeighborCell(graph, cell, [&workspace](CellIndex neighbor) {
+            if (!workspace.isVisited(neighbor)) {
+                workspace.push(neighbor);
+            }
+        });
+    }
+}
+
+void multiSourceReachableCellsBfs(const MazeGraph& graph,
+                                  const std::vector<CellIndex>& sources,
+                                  BfsWorkspace& workspace) {
+    auto& result = workspace.reachableCellsBuffer();
+    for (size_t i = 0; i < sources.size(); ++i) {
+        const auto source_index = static_cast<CellIndex>(i);
+        if (workspace.isVisited(sources[i])) {
+            continue;
+        }
+        workspace.push(sources[i]);
+        result.push_back(ReachableCell{source_index, sources[i]});
+        while (!workspace.isQueueEmpty()) {
+            const CellIndex cell = workspace.pop();
+            forEachNeighborCell(graph, cell, [&](CellIndex neighbor) {
+                if (!workspace.isVisited(neighbor)) {
+                    workspace.push(neighbor);
+                    result.push_back(ReachableCell{source_index, neighbor});
+                }
+            });
+        }
+    }
+}
+
+bool isStraight(OutPaths out_paths) {
+    const auto north_south = static_cast<OutPathsIntegerType>(OutPaths::North) |
+                             static_cast<OutPathsIntegerType>(OutPaths::South);
+    const auto east_west = static_cast<OutPathsIntegerType>(OutPaths::East) |
+                           static_cast<OutPathsIntegerType>(OutPaths::West);
+    const auto value = static_cast<OutPathsIntegerType>(out_paths);
+    return value == north_south || value == east_west;
+}
+
+} // anonymous namespace
+
+void BfsWorkspace::reset(size_t num_cells) {
+    if (visited_.size() < num_cells) {
+        visited_.assign(num_cells, 0);
+        queue_.resize(num_cells);
+        parents_.resize(num_cells);
+        cells_.reserve(num_cells);
+        reachable_cells_.reserve(num_cells);
+        epoch_ = 0;
+    }
+    ++epoch_;
+    if (epoch_ == 0) {
+        std::fill(visited_.begin(), visited_.end(), 0);
+        epoch_ = 1;
+    }
+    queue_begin_ = 0;
+    queue_end_ = 0;
+    cells_.clear();
+    reachable_cells_.clear();
+}
+
+void ChildrenReachability::compute(const MazeGraph& graph,
+                                   const std::vector<CellIndex>& sources,
+                                   const Location& previous_shift) {
+    const CellLayout& layout = graph.getLayout();
+    num_words_ = (layout.getNumberOfCells() + 63) / 64;
+    children_.clear();
+    reached_cells_.clear();
+    const auto max_rotation = isStraight(graph.getLeftover().out_paths) ? 1 : 3;
+    const Location invalid_shift_location = opposingShiftLocation(previous_shift, graph.getExtent());
+    for (const Location& shift_location : graph.getShiftLocations()) {
+        if (shift_location != invalid_shift_location) {
+            for (auto rotation_value = 0; rotation_value <= max_rotation; ++rotation_value) {
+                children_.push_back(Child{shift_location, static_cast<RotationDegreeType>(rotation_value), 0, 0});
+            }
+        }
+    }
+    reached_bits_.assign(children_.size() * num_words_, 0);
+    for (size_t first_child = 0; first_child < children_.size(); first_child += BitSlicedMazes::max_boards) {
+        const size_t num_boards = std::min(children_.size() - first_child, BitSlicedMazes::max_boards);
+        setBoards(graph, first_child, num_boards);
+        growComponents(layout, sources, first_child, num_boards);
+        for (size_t board = 0; board < num_boards; ++board) {
+            addReachedCells(layout, sources, num_boards, board, first_child + board);
+        }
+    }
+}
+
+void ChildrenReachability::setBoards(const MazeGraph& graph, size_t first_child, size_t num_boards) {
+    const CellLayout& layout = graph.getLayout();
+    const MazeGraph::ExtentType extent = graph.getExtent();
+    const auto leftover_out_paths = static_cast<OutPathsIntegerType>(graph.getLeftover().out_paths);
+    sliced_mazes_.setAllBoards(graph);
+    for (size_t board = 0; board < num_boards; ++board) {
+        const Child& child = children_[first_child + board];
+        const Location& shift_location = child.shift_location;
+        const CellIndex shift_cell = layout.toCellIndex(shift_location);
+        // Moves the cells of the shifted line, and inserts the leftover instead of the pushed-out cell.
+        const bool is_column_shifted = shift_location.getRow() == 0 || shift_location.getRow() == extent - 1;
+        for (auto position = 0; position < extent; ++position) {
+            const Location location = is_column_shifted ? Location{position, shift_location.getColumn()}
+                                                        : Location{shift_location.getRow(), position};
+            const CellIndex shifted_cell = layout.translateByShift(layout.toCellIndex(location), shift_cell);
+            if (shifted_cell != shift_cell) {
+                sliced_mazes_.setOutPaths(board, shifted_cell, graph.getRotatedOutPaths(location));
             }
         }
+        sliced_mazes_.setOutPaths(board, shift_cell, rotateOutPaths(leftover_out_paths, child.rotation));
+    }
+}
+
+void ChildrenReachability::growComponents(const CellLayout& layout,
+                                          const std::vector<CellIndex>& sources,
+                                          size_t first_child,
+                                          size_t num_boards) {
+    // As the reached cells of previous rounds form complete components, the cells which are added in a round form
+    // the component of the source added in this round.
+    next_sources_.assign(num_boards, 0);
+    round_sources_.clear();
+    round_reached_.clear();
+    bool has_added_source = true;
+    while (has_added_source) {
+        has_added_source = false;
+        for (size_t board = 0; board < num_boards; ++board) {
+            size_t& next_source = next_sources_[board];
+            while (next_source < sources.size() &&
+                   sliced_mazes_.isReached(board, childSource(layout, sources[next_source], first_child + board))) {
+                ++next_source;
+            }
+            if (next_source < sources.size()) {
+                sliced_mazes_.addSource(board, childSource(layout, sources[next_source], first_child + board));
+                round_sources_.push_back(next_source);
+                ++next_source;
+                has_added_source = true;
+            } else {
+                round_sources_.push_back(sources.size());
+            }
+        }
+        if (has_added_source) {
+            sliced_mazes_.floodFill();
+            const auto& reached = sliced_mazes_.getReachedSlices();
+            round_reached_.insert(round_reached_.end(), reached.begin(), reached.end());
+        }
+    }
+}
+
+void ChildrenReachability::addReachedCells(const CellLayout& layout,
+                                           const std::vector<CellIndex>& sources,
+                                           size_t num_boards,
+                                           size_t board,
+                                           size_t child_index) {
+    const size_t num_cells = layout.getNumberOfCells();
+    const size_t num_rounds = round_reached_.size() / num_cells;
+    WordType* bits = &reached_bits_[child_index * num_words_];
+    children_[child_index].first_reached_cell = reached_cells_.size();
+    for (size_t round = 0; round < num_rounds; ++round) {
+        const size_t source_index = round_sources_[round * num_boards + board];
+        if (source_index == sources.size()) {
+            break;
+        }
+        const CellIndex source = childSource(layout, sources[source_index], child_index);
+        reached_cells_.push_back(ReachableCell{static_cast<CellIndex>(source_index), source});
+        const WordType* reached = &round_reached_[round * num_cells];
+        for (CellIndex cell = 0; cell < num_cells; ++cell) {
+            const bool is_reached = (reached[cell] >> board) & 1u;
+            const bool was_reached = (bits[cell / 64] >> (cell % 64)) & 1u;
+            if (is_reached && !was_reached) {
+                bits[cell / 64] |= WordType{1} << (cell % 64);
+                if (cell != source) {
+                    reached_cells_.push_back(ReachableCell{static_cast<CellIndex>(source_index), cell});
+                }
+            }
+        }
+    }
+    children_[child_index].end_reached_cell = reached_cells_.size();
+}
+
+bool isReachable(const MazeGraph& graph, const Location& source, const Location& target) {
+    BfsWorkspace workspace;
+    return isReachable(graph, source, target, workspace);
+}
+
+std::vector<bool> areReachable(const MazeGraph& graph, const Location& source, const std::vector<Location>& targets) {
+    const CellLayout& layout = graph.getLayout();
+    std::vector<bool> result(targets.size(), false);
+    if (!MazeBitBoard::supportsExtent(graph.getExtent())) {
+        if (RowMaskBoard::supportsExtent(graph.getExtent())) {
+            const RowMaskBoard row_mask_board{graph};
+            const RowMaskBoard::Rows reached = row_mask_board.floodFill(RowMaskBoard::singleCell(source));
+            for (size_t i = 0; i < targets.size(); ++i) {
+                result[i] = RowMaskBoard::test(reached, targets[i]);
+            }
+            return result;
+        }
+        BfsWorkspace workspace;
+        workspace.reset(layout.getNumberOfCells());
+        reachableCellsBfs(graph, layout.toCellIndex(source), workspace);
+        for (size_t i = 0; i < targets.size(); ++i) {
+            result[i] = workspace.isVisited(layout.toCellIndex(targets[i]));
+        }
+        return result;
+    }
+    const MazeBitBoard bit_board{graph};
+    const BitBoard reached = bit_board.floodFill(BitBoard::singleBit(bit_board.toIndex(source)));
+    for (size_t i = 0; i < targets.size(); ++i) {
+        result[i] = reached.test(bit_board.toIndex(targets[i]));
+    }
+    return result;
+}
+
+std::vector<Location> reachableLocations(const MazeGraph& graph, const Location& source) {
+    const CellLayout& layout = graph.getLayout();
+    BfsWorkspace workspace;
+    const std::vector<CellIndex>& cells = reachableCells(graph, layout.toCellIndex(source), workspace);
+    std::vector<Location> result;
+    result.reserve(cells.size());
+    for (CellIndex cell : cells) {
+        result.push_back(layout.toLocation(cell));
     }
     return result;
 }
 
 std::vector<ReachableNode> multiSourceReachableLocations(const MazeGraph& graph, const std::vector<Location>& sources) {
-    constexpr size_t no_parent = std::numeric_limits<size_t>::max();
+    const CellLayout& layout = graph.getLayout();
+    std::vector<CellIndex> source_cells;
+    source_cells.reserve(sources.size());
+    for (const auto& source : sources) {
+        source_cells.push_back(layout.toCellIndex(source));
+    }
+    BfsWorkspace workspace;
+    const std::vector<ReachableCell>& cells = multiSourceReachableCells(graph, source_cells, workspace);
     std::vector<ReachableNode> result;
-    result.reserve(sources.size());
-    std::vector<size_t> parent_indices(graph.getNumberOfNodes(), no_parent);
-    std::queue<Location> q;
+    result.reserve(cells.size());
+    for (const auto& reachable_cell : cells) {
+        result.emplace_back(reachable_cell.parent_source_index, layout.toLocation(reachable_cell.reached_cell));
+    }
+    return result;
+}
+
+std::vector<CellIndex> reachableCells(const MazeGraph& graph, CellIndex source) {
+    BfsWorkspace workspace;
+    return reachableCells(graph, source, workspace);
+}
+
+std::vector<ReachableCell> multiSourceReachableCells(const MazeGraph& graph, const std::vector<CellIndex>& sources) {
+    BfsWorkspace workspace;
+    return multiSourceReachableCells(graph, sources, workspace);
+}
+
+void distanceMap(const MazeGraph& graph, const std::vector<CellIndex>& sources, std::vector<CellDistance>& distances) {
+    BfsWorkspace workspace;
+    distanceMap(graph, sources, distances, workspace);
+}
+
+CellIndex closestReachableCell(const MazeGraph& graph, CellIndex source, CellIndex target) {
+    BfsWorkspace workspace;
+    return closestReachableCell(graph, source, target, workspace);
+}
+
+ChildrenReachability allChildrenReachability(const MazeGraph& graph,
+                                             const std::vector<CellIndex>& sources,
+                                             const Location& previous_shift) {
+    ChildrenReachability result;
+    result.compute(graph, sources, previous_shift);
+    return result;
+}
+
+bool isReachable(const MazeGraph& graph,
+                 const Location& source,
+                 const Location& target,
+                 BfsWorkspace& workspace,
+                 ReachabilityStrategy strategy) {
+    const CellLayout& layout = graph.getLayout();
+    if (!MazeBitBoard::supportsExtent(graph.getExtent())) {
+        const CellIndex source_cell = layout.toCellIndex(source);
+        const CellIndex target_cell = layout.toCellIndex(target);
+        switch (strategy) {
+        case ReachabilityStrategy::bidirectional:
+            return isReachableBidirectional(graph, source_cell, target_cell, workspace);
+        case ReachabilityStrategy::goal_directed:
+            return isReachableGoalDirected(graph, source_cell, target_cell, workspace);
+        default:
+            return isReachableForward(graph, source_cell, target_cell, workspace);
+        }
+    }
+    const MazeBitBoard bit_board{graph};
+    if (strategy == ReachabilityStrategy::bidirectional) {
+        return bit_board.connectsBidirectional(bit_board.toIndex(source), bit_board.toIndex(target));
+    }
+    return bit_board.connects(bit_board.toIndex(source), bit_board.toIndex(target));
+}
+
+const std::vector<CellIndex>& reachableCells(const MazeGraph& graph, CellIndex source, BfsWorkspace& workspace) {
+    const CellLayout& layout = graph.getLayout();
+    workspace.reset(layout.getNumberOfCells());
+    if (!RowMaskBoard::supportsExtent(graph.getExtent())) {
+        reachableCellsBfs(graph, source, workspace);
+        return workspace.cellsBuffer();
+    }
+    // A RowMaskBoard is used for all extents it supports, as it is at least as fast as a MazeBitBoard here.
+    auto& result = workspace.cellsBuffer();
+    const RowMaskBoard row_mask_board{graph};
+    const RowMaskBoard::Rows reached = row_mask_board.floodFill(RowMaskBoard::singleCell(layout.toLocation(source)));
+    result.push_back(source);
+    row_mask_board.forEachCell(reached, [&result, source](CellIndex cell) {
+        if (cell != source) {
+            result.push_back(cell);
+        }
+    });
+    return result;
+}
+
+const std::vector<ReachableCell>& multiSourceReachableCells(const MazeGraph& graph,
+                                                            const std::vector<CellIndex>& sources,
+                                                            BfsWorkspace& workspace) {
+    // Each source reaches its whole connected component. Therefore, a source which lies in the component of a
+    // previous source does not reach any new locations, and the reached locations are attributed to the first source.
+    const CellLayout& layout = graph.getLayout();
+    workspace.reset(layout.getNumberOfCells());
+    if (!RowMaskBoard::supportsExtent(graph.getExtent())) {
+        multiSourceReachableCellsBfs(graph, sources, workspace);
+        return workspace.reachableCellsBuffer();
+    }
+    auto& result = workspace.reachableCellsBuffer();
+    const RowMaskBoard row_mask_board{graph};
+    RowMaskBoard::Rows reached{};
     for (size_t i = 0; i < sources.size(); ++i) {
-        q.push(sources[i]);
-        parent_indices[graph.getNode(sources[i]).node_id] = i;
-        result.emplace_back(i, sources[i]);
-    }
-    while (!q.empty()) {
-        auto location = q.front();
-        auto parent_index = parent_indices[graph.getNode(location).node_id];
-        q.pop();
-        for (auto neighbor_it = graph.neighbors(location); !neighbor_it.isAtEnd(); ++neighbor_it) {
-            if (no_parent == parent_indices[graph.getNode(*neighbor_it).node_id]) {
-                parent_indices[graph.getNode(*neighbor_it).node_id] = parent_index;
-                q.push(*neighbor_it);
-                result.emplace_back(parent_index, *neighbor_it);
+        const auto source_index = static_cast<CellIndex>(i);
+        const CellIndex source = sources[i];
+        const Location source_location = layout.toLocation(source);
+        if (RowMaskBoard::test(reached, source_location)) {
+            continue;
+        }
+        const RowMaskBoard::Rows component = row_mask_board.floodFill(RowMaskBoard::singleCell(source_location));
+        result.push_back(ReachableCell{source_index, source});
+        row_mask_board.forEachCell(component, [&result, source_index, source](CellIndex cell) {
+            if (cell != source) {
+                result.push_back(ReachableCell{source_index, cell});
             }
+        });
+        for (size_t row = 0; row < reached.size(); ++row) {
+            reached[row] |= component[row];
         }
     }
     return result;
 }
 
+void distanceMap(const MazeGraph& graph,
+                 const std::vector<CellIndex>& sources,
+                 std::vector<CellDistance>& distances,
+                 BfsWorkspace& workspace) {
+    const size_t num_cells = graph.getLayout().getNumberOfCells();
+    distances.assign(num_cells, CellDistance{});
+    workspace.reset(num_cells);
+    for (size_t i = 0; i < sources.size(); ++i) {
+        const CellIndex source = sources[i];
+        if (!workspace.isVisited(source)) {
+            workspace.push(source);
+            distances[source] = CellDistance{0, static_cast<CellIndex>(i)};
+        }
+    }
+    while (!workspace.isQueueEmpty()) {
+        const CellIndex cell = workspace.pop();
+        const CellDistance neighbor_distance{static_cast<CellIndex>(distances[cell].distance + 1),
+                                             distances[cell].nearest_source_index};
+        forEachNeighborCell(graph, cell, [&workspace, &distances, &neighbor_distance](CellIndex neighbor) {
+            if (!workspace.isVisited(neighbor)) {
+                workspace.push(neighbor);
+                distances[neighbor] = neighbor_distance;
+            }
+        });
+    }
+}
+
+CellIndex closestReachableCell(const MazeGraph& graph, CellIndex source, CellIndex target, BfsWorkspace& workspace) {
+    const CellLayout& layout = graph.getLayout();
+    const Location target_location = layout.toLocation(target);
+    const auto distance_to_target = [&layout, &target_location](CellIndex cell) {
+        return manhattanDistance(layout.toLocation(cell), target_location);
+    };
+    // The cells are visited in the order of their path length, so the first of several closest cells is kept.
+    CellIndex closest_cell = source;
+    int closest_distance = distance_to_target(source);
+    workspace.reset(layout.getNumberOfCells());
+    workspace.push(source);
+    while (!workspace.isQueueEmpty() && closest_distance != 0) {
+        const CellIndex cell = workspace.pop();
+        const int distance = distance_to_target(cell);
+        if (distance < closest_distance) {
+            closest_cell = cell;
+            closest_distance = distance;
+        }
+        forEachNeighborCell(graph, cell, [&workspace](CellIndex neighbor) {
+            if (!workspace.isVisited(neighbor)) {
+                workspace.push(neighbor);
+            }
+        });
+    }
+    return closest_cell;
+}
+
 } // namespace reachable
 } // namespace labyrinth
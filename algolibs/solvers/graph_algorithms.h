@@ -1,8 +1,11 @@
 #pragma once
 
+#include "bitsliced.h"
 #include "location.h"
 #include "maze_graph.h"
 
+#include <cstdint>
+#include <limits>
 #include <utility>
 #include <vector>
 
@@ -17,12 +20,235 @@ struct ReachableNode {
     Location reached_location;
 };
 
+/// Reachable cell together with the index of its source, cf. multiSourceReachableCells().
+struct ReachableCell {
+    CellIndex parent_source_index;
+    CellIndex reached_cell;
+};
+
+/// Number of steps from the nearest source to a cell, together with the index of that source, cf. distanceMap().
+struct CellDistance {
+    static constexpr CellIndex unreachable = std::numeric_limits<CellIndex>::max();
+
+    bool isReachable() const noexcept { return distance != unreachable; }
+
+    CellIndex distance{unreachable};
+    CellIndex nearest_source_index{unreachable};
+};
+
+/// Strategy of a single reachability query, cf. isReachable().
+enum class ReachabilityStrategy {
+    /// expands the reached cells from the source only
+    forward,
+    /// expands the reached cells from the source and from the target alternately, until they meet
+    bidirectional,
+    /// depth-first search, which first follows the out paths leading towards the target.
+    /// Mazes which can be represented by a MazeBitBoard are searched forward instead.
+    goal_directed
+};
+
+/// Reusable buffers for the reachability computations below.
+///
+/// Visited cells are marked with the number of the current traversal (epoch), so that the marks do not have to be
+/// cleared between traversals. The queue has a fixed capacity of one entry per cell, as each cell is enqueued at most
+/// once. The results are written to output buffers owned by the workspace, which remain valid until the next
+/// computation with the same workspace.
+/// After the first computations on a maze of a given size, a workspace does not allocate any more.
+/// A workspace must not be used by multiple threads concurrently.
+class BfsWorkspace {
+public:
+    /// Starts a new traversal of a maze with the given number of cells.
+    void reset(size_t num_cells);
+
+    bool isVisited(CellIndex cell) const noexcept { return visited_[cell] == epoch_; }
+
+    void visit(CellIndex cell) noexcept { visited_[cell] = epoch_; }
+
+    /// Marks the cell as visited, and enqueues it.
+    void push(CellIndex cell) noexcept {
+        visit(cell);
+        queue_[queue_end_++] = cell;
+    }
+
+    CellIndex pop() noexcept { return queue_[queue_begin_++]; }
+
+    /// Removes the most recently enqueued cell, i.e. uses the queue as stack.
+    CellIndex popLast() noexcept { return queue_[--queue_end_]; }
+
+    bool isQueueEmpty() const noexcept { return queue_begin_ == queue_end_; }
+
+    /// Only valid for visited cells.
+    CellIndex getParent(CellIndex cell) const noexcept { return parents_[cell]; }
+
+    void setParent(CellIndex cell, CellIndex parent) noexcept { parents_[cell] = parent; }
+
+    std::vector<CellIndex>& cellsBuffer() noexcept { return cells_; }
+
+    std::vector<ReachableCell>& reachableCellsBuffer() noexcept { return reachable_cells_; }
+
+private:
+    using EpochType = uint32_t;
+
+    std::vector<EpochType> visited_;
+    EpochType epoch_{0};
+    std::vector<CellIndex> queue_;
+    size_t queue_begin_{0};
+    size_t queue_end_{0};
+    std::vector<CellIndex> parents_;
+    std::vector<CellIndex> cells_;
+    std::vector<ReachableCell> reachable_cells_;
+};
+
+/// Reachable cells of all children of a game state, cf. allChildrenReachability().
+///
+/// A child is the state after one shift with one rotation of the inserted leftover. For each child, the reached cells
+/// are stored as bitset over the cell indices, and as list of ReachableCells in the order of
+/// multiSourceReachableCells(), i.e. each source is followed by the other cells of its component in ascending order.
+/// The object also keeps the buffers of the computation, so that reusing it does not allocate after the first
+/// computations on a maze of a given size.
+class ChildrenReachability {
+public:
+    using WordType = BitSlicedMazes::WordType;
+    using ReachedCellIterator = std::vector<ReachableCell>::const_iterator;
+
+    struct Child {
+        Location shift_location;
+        RotationDegreeType rotation;
+        size_t first_reached_cell;
+        size_t end_reached_cell;
+    };
+
+    /// Computes the children of the given maze, where the player is located at one of the sources.
+    /// The children are ordered as the shift locations of the graph, and by ascending rotation for each shift location.
+    /// The shift which would revert the previous shift is left out, and straight leftovers are only inserted with
+    /// rotations 0 and 90.
+    void compute(const MazeGraph& graph, const std::vector<CellIndex>& sources, const Location& previous_shift);
+
+    size_t getNumberOfChildren() const noexcept { return children_.size(); }
+
+    const Child& getChild(size_t child_index) const noexcept { return children_[child_index]; }
+
+    ReachedCellIterator reachedCellsBegin(size_t child_index) const noexcept {
+        return reached_cells_.begin() + children_[child_index].first_reached_cell;
+    }
+
+    ReachedCellIterator reachedCellsEnd(size_t child_index) const noexcept {
+        return reached_cells_.begin() + children_[child_index].end_reached_cell;
+    }
+
+    bool isReached(size_t child_index, CellIndex cell) const noexcept {
+        return (reached_bits_[child_index * num_words_ + cell / 64] >> (cell % 64)) & 1u;
+    }
+
+    /// Returns the reached cells of a child as bitset over the cell indices, of getNumberOfWords() words.
+    const WordType* getReachedBits(size_t child_index) const noexcept {
+        return reached_bits_.data() + child_index * num_words_;
+    }
+
+    size_t getNumberOfWords() const noexcept { return num_words_; }
+
+private:
+    /// Stores the children with the given indices as boards of sliced_mazes_.
+    void setBoards(const MazeGraph& graph, size_t first_child, size_t num_boards);
+
+    /// Grows the components of the sources in the boards of sliced_mazes_, in rounds. In each round, the first source
+    /// of each board which has not been reached yet is added, and the reached cells are recorded.
+    void growComponents(const CellLayout& layout,
+                        const std::vector<CellIndex>& sources,
+                        size_t first_child,
+                        size_t num_boards);
+
+    /// Adds the reached cells of the given board, which is the child with the given index, cf. growComponents().
+    void addReachedCells(const CellLayout& layout,
+                         const std::vector<CellIndex>& sources,
+                         size_t num_boards,
+                         size_t board,
+                         size_t child_index);
+
+    CellIndex childSource(const CellLayout& layout, CellIndex source, size_t child_index) const noexcept {
+        return layout.translateByShift(source, layout.toCellIndex(children_[child_index].shift_location));
+    }
+
+    std::vector<Child> children_;
+    std::vector<ReachableCell> reached_cells_;
+    std::vector<WordType> reached_bits_;
+    size_t num_words_{0};
+    // buffers for the computation of a batch of up to 64 children
+    BitSlicedMazes sliced_mazes_;
+    std::vector<size_t> next_sources_;
+    // for each round and board, the index of the added source, or the number of sources if none has been added
+    std::vector<size_t> round_sources_;
+    // for each round, the bit-sliced reached cells after the round
+    std::vector<WordType> round_reached_;
+};
+
+/// Checks if the target can be reached from the source, with a bidirectional search.
 bool isReachable(const MazeGraph& graph, const Location& source, const Location& target);
 
+/// Checks for each of the targets if it can be reached from the source, with a single flood fill.
+/// Mazes which are too large for a MazeBitBoard use a RowMaskBoard, which is vectorized where available, and mazes
+/// which are too large for a RowMaskBoard use a breadth-first search.
+std::vector<bool> areReachable(const MazeGraph& graph, const Location& source, const std::vector<Location>& targets);
+
+/// Returns the locations which can be reached from the source. The source is always the first one.
 std::vector<Location> reachableLocations(const MazeGraph& graph, const Location& source);
 
+/// Returns the locations which can be reached from any of the sources, each with the index of a source it is
+/// reachable from. Each source reaches its whole connected component, which is attributed to the first source in it:
+/// that source is followed by the other locations of the component.
+/// A source which lies in the component of a previous source is not reported at all, not even with its own location.
+/// Hence, not every source necessarily occurs in the result.
 std::vector<ReachableNode> multiSourceReachableLocations(const MazeGraph& graph, const std::vector<Location>& sources);
 
+/// Same as reachableLocations(), with cells instead of locations.
+std::vector<CellIndex> reachableCells(const MazeGraph& graph, CellIndex source);
+
+/// Same as multiSourceReachableLocations(), with cells instead of locations. In particular, a source in the component
+/// of a previous source does not occur in the result.
+/// Expects the sources to be pairwise distinct, so that their indices fit into a CellIndex.
+std::vector<ReachableCell> multiSourceReachableCells(const MazeGraph& graph, const std::vector<CellIndex>& sources);
+
+/// Computes the reachable cells of all children of a game state at once, cf. ChildrenReachability.
+///
+/// Instead of searching each child separately, up to 64 children are flood-filled simultaneously as bit-sliced
+/// boards, cf. BitSlicedMazes. The boards are derived from the given maze without shifting it, by only setting the
+/// cells of the shifted line.
+ChildrenReachability allChildrenReachability(const MazeGraph& graph,
+                                             const std::vector<CellIndex>& sources,
+                                             const Location& previous_shift);
+
+/// Computes the number of steps from the nearest source for each cell, with a breadth-first search from all sources.
+/// The result is written to the given buffer, indexed by cell. Cells which cannot be reached from any source are left
+/// at CellDistance::unreachable. If several sources are equally near to a cell, one of them is chosen.
+void distanceMap(const MazeGraph& graph, const std::vector<CellIndex>& sources, std::vector<CellDistance>& distances);
+
+/// Returns the reachable cell which is closest to the target, in terms of the Manhattan distance on the board.
+/// Of several equally close cells, the one with the shortest path from the source is returned.
+/// In particular, returns the target if it is reachable.
+CellIndex closestReachableCell(const MazeGraph& graph, CellIndex source, CellIndex target);
+
+// The following overloads carry out the computations with the buffers of the given workspace.
+// The returned references point into the workspace.
+
+bool isReachable(const MazeGraph& graph,
+                 const Location& source,
+                 const Location& target,
+                 BfsWorkspace& workspace,
+                 ReachabilityStrategy strategy = ReachabilityStrategy::bidirectional);
+
+const std::vector<CellIndex>& reachableCells(const MazeGraph& graph, CellIndex source, BfsWorkspace& workspace);
+
+const std::vector<ReachableCell>& multiSourceReachableCells(const MazeGraph& graph,
+                                                            const std::vector<CellIndex>& sources,
+                                                            BfsWorkspace& workspace);
+
+void distanceMap(const MazeGraph& graph,
+                 const std::vector<CellIndex>& sources,
+                 std::vector<CellDistance>& distances,
+                 BfsWorkspace& workspace);
+
+CellIndex closestReachableCell(const MazeGraph& graph, CellIndex source, CellIndex target, BfsWorkspace& workspace);
+
 } // namespace reachable
 
 } // namespace labyrinth
@@ -9,7 +9,7 @@ public:
     using IndexType = int16_t;
     struct OffsetType {
         using OffsetValueType = int16_t;
-        explicit OffsetType(OffsetValueType row, OffsetValueType column) noexcept :
+        constexpr explicit OffsetType(OffsetValueType row, OffsetValueType column) noexcept :
             row_offset{row}, column_offset{column} {}
         OffsetValueType row_offset{0};
         OffsetValueType column_offset{0};
@@ -32,11 +32,11 @@ public:
     const Location& operator+=(const OffsetType& offset) noexcept;
     const Location& operator-=(const OffsetType& offset) noexcept;
 
-    IndexType getRow() const { // embind does not work with noexcept specifier
+    constexpr IndexType getRow() const { // embind does not work with noexcept specifier
         return row_;
     }
 
-    IndexType getColumn() const { // embind does not work with noexcept specifier
+    constexpr IndexType getColumn() const { // embind does not work with noexcept specifier
         return column_;
     }
 
@@ -52,15 +52,15 @@ private:
     IndexType column_{0};
 };
 
-inline bool operator==(const labyrinth::Location& lhs, const labyrinth::Location& rhs) noexcept {
+constexpr bool operator==(const labyrinth::Location& lhs, const labyrinth::Location& rhs) noexcept {
     return lhs.getRow() == rhs.getRow() && lhs.getColumn() == rhs.getColumn();
 }
 
-inline bool operator!=(const labyrinth::Location& lhs, const labyrinth::Location& rhs) noexcept {
+constexpr bool operator!=(const labyrinth::Location& lhs, const labyrinth::Location& rhs) noexcept {
     return !(lhs == rhs);
 }
 
-inline bool operator<(const labyrinth::Location& lhs, const labyrinth::Location& rhs) noexcept {
+constexpr bool operator<(const labyrinth::Location& lhs, const labyrinth::Location& rhs) noexcept {
     if (lhs.getRow() < rhs.getRow())
         return true;
     if (lhs.getRow() > rhs.getRow())
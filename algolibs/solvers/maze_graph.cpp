@@ -2,6 +2,8 @@
 #include "location.h"
 #include <algorithm>
 #include <array>
+#include <memory>
+#include <type_traits>
 #include <vector>
 
 namespace labyrinth {
@@ -48,6 +50,34 @@ RotationDegreeType operator-(RotationDegreeType rotation) {
     return static_cast<RotationDegreeType>(4 - static_cast<RotationDegreeIntegerType>(rotation));
 }
 
+void rotateOffset(Location::IndexType& offset,
+                  Location::OffsetType::OffsetValueType delta,
+                  MazeGraph::ExtentType extent,
+                  size_t& num_rotated_lines) noexcept {
+    const bool was_rotated = offset != 0;
+    offset = static_cast<Location::IndexType>((offset + delta + extent) % extent);
+    const bool is_rotated = offset != 0;
+    if (is_rotated && !was_rotated) {
+        ++num_rotated_lines;
+    } else if (was_rotated && !is_rotated) {
+        --num_rotated_lines;
+    }
+}
+
+/// Rotates a column of a row-major matrix, which starts at first, in the same way as std::rotate() rotates a range:
+/// the element in row middle becomes the first one. The column is rotated in place by three reversals.
+template <typename Iterator>
+void rotateColumn(Iterator first, MazeGraph::ExtentType extent, MazeGraph::ExtentType middle) {
+    const auto reverse_rows = [first, extent](MazeGraph::ExtentType begin_row, MazeGraph::ExtentType end_row) {
+        for (--end_row; begin_row < end_row; ++begin_row, --end_row) {
+            std::iter_swap(first + begin_row * extent, first + end_row * extent);
+        }
+    };
+    reverse_rows(0, middle);
+    reverse_rows(middle, extent);
+    reverse_rows(0, extent);
+}
+
 } // anonymous namespace
 
 RotationDegreeType nextRotation(RotationDegreeType rotation) {
@@ -59,33 +89,100 @@ bool hasOutPath(const Node& node, OutPaths out_path) {
     return static_cast<OutPathsIntegerType>(node.out_paths) & static_cast<OutPathsIntegerType>(out_path_to_check);
 }
 
-MazeGraph::MazeGraph(ExtentType extent) : size_{static_cast<SizeType>(extent * extent)}, extent_{extent} {
+MazeGraph::CellArrays::CellArrays(SizeType num_cells, ExtentType extent) :
+    num_cells_{num_cells},
+    extent_{extent},
+    buffer_{new unsigned char[bufferSize(num_cells, extent)]} {
+    createArrays(nullptr);
+}
+
+MazeGraph::CellArrays::CellArrays(const CellArrays& other) :
+    num_cells_{other.num_cells_},
+    extent_{other.extent_},
+    buffer_{new unsigned char[bufferSize(num_cells_, extent_)]} {
+    createArrays(&other);
+}
+
+MazeGraph::CellArrays& MazeGraph::CellArrays::operator=(const CellArrays& other) {
+    if (this != &other) {
+        *this = CellArrays{other};
+    }
+    return *this;
+}
+
+size_t MazeGraph::CellArrays::bufferSize(SizeType num_cells, ExtentType extent) noexcept {
+    return num_cells * (sizeof(NodeId) + sizeof(TileType) + sizeof(OutPathsIntegerType)) +
+           (num_cells + 1) * sizeof(CellIndex) + 2 * static_cast<size_t>(extent) * sizeof(IndexType);
+}
+
+void MazeGraph::CellArrays::createArrays(const CellArrays* source) {
+    // The arrays are placed in order of decreasing alignment, so that each of them is aligned.
+    unsigned char* position = buffer_.get();
+    const auto create = [&position](auto*& array, size_t size, const auto* source_array) {
+        using ValueType = std::remove_reference_t<decltype(*array)>;
+        array = reinterpret_cast<ValueType*>(position);
+        if (source_array != nullptr) {
+            std::uninitialized_copy_n(source_array, size, array);
+        } else {
+            std::uninitialized_value_construct_n(array, size);
+        }
+        position += size * sizeof(ValueType);
+    };
+    create(node_ids, num_cells_, source ? source->node_ids : nullptr);
+    create(node_indices, num_cells_ + 1, source ? source->node_indices : nullptr);
+    create(row_offsets, extent_, source ? source->row_offsets : nullptr);
+    create(column_offsets, extent_, source ? source->column_offsets : nullptr);
+    create(tiles, num_cells_, source ? source->tiles : nullptr);
+    create(connected_edges, num_cells_, source ? source->connected_edges : nullptr);
+}
+
+MazeGraph::MazeGraph(ExtentType extent) :
+    size_{static_cast<SizeType>(extent * extent)},
+    extent_{extent},
+    layout_{std::make_shared<const CellLayout>(extent_)},
+    cells_{size_, extent_} {
     NodeId current = 0;
-    node_matrix_.resize(size_);
     for (auto row = 0; row < extent_; row++) {
         for (auto column = 0; column < extent_; column++) {
-            getNode(Location{row, column}).node_id = current++;
+            cells_.node_ids[row * extent_ + column] = current++;
         }
     }
     leftover_.node_id = current;
+    buildNodeIndex();
+    updateConnectedEdges(0, extent_, 0, extent_);
+    computeHashes();
 }
 
 MazeGraph::MazeGraph(const std::vector<Node>& nodes) :
-    size_{nodes.size() - 1}, extent_{static_cast<ExtentType>(integerSquareRoot(nodes.size()))} {
+    size_{nodes.size() - 1},
+    extent_{static_cast<ExtentType>(integerSquareRoot(nodes.size()))},
+    layout_{std::make_shared<const CellLayout>(extent_)},
+    cells_{size_, extent_} {
     auto current_input = nodes.begin();
-    node_matrix_.resize(size_);
     for (auto row = 0; row < extent_; row++) {
         for (auto column = 0; column < extent_; column++) {
-            auto& node = getNode(Location{row, column});
-            node = *current_input;
+            storeNode(row * extent_ + column, *current_input);
             ++current_input;
         }
     }
     leftover_ = *current_input;
+    buildNodeIndex();
+    updateConnectedEdges(0, extent_, 0, extent_);
+    computeHashes();
 }
 
 void MazeGraph::setOutPaths(const Location& location, OutPaths out_paths) {
-    getNode(location).out_paths = out_paths;
+    const SizeType matrix_index = matrixIndex(location);
+    cells_.tiles[matrix_index] = toTile(out_paths, static_cast<RotationDegreeType>(cells_.tiles[matrix_index] >> 4));
+    updateConnectedEdgesAround(location);
+}
+
+void MazeGraph::setRotation(const Location& location, RotationDegreeType rotation) {
+    const SizeType matrix_index = matrixIndex(location);
+    toggleKey(nodeKey(location));
+    cells_.tiles[matrix_index] = toTile(static_cast<OutPaths>(cells_.tiles[matrix_index] & 15u), rotation);
+    toggleKey(nodeKey(location));
+    updateConnectedEdgesAround(location);
 }
 
 void MazeGraph::addShiftLocation(const Location& location) {
@@ -99,10 +196,14 @@ void MazeGraph::setLeftoverOutPaths(OutPaths out_paths) {
 }
 
 Location MazeGraph::getLocation(NodeId node_id, const Location& leftover_location) const {
+    if (node_id < getNumberOfNodes()) {
+        const SizeType matrix_index = cells_.node_indices[node_id];
+        return matrix_index < size_ ? locationOfMatrixIndex(matrix_index) : leftover_location;
+    }
     for (Location::IndexType row = 0; row < extent_; ++row) {
         for (Location::IndexType column = 0; column < extent_; ++column) {
             Location location{row, column};
-            if (getNode(location).node_id == node_id) {
+            if (getNodeId(location) == node_id) {
                 return location;
             }
         }
@@ -110,8 +211,131 @@ Location MazeGraph::getLocation(NodeId node_id, const Location& leftover_locatio
     return leftover_location;
 }
 
+void MazeGraph::buildNodeIndex() {
+    const auto not_found = static_cast<CellIndex>(size_ + 1);
+    std::fill_n(cells_.node_indices, getNumberOfNodes(), not_found);
+    for (SizeType matrix_index = 0; matrix_index < size_; ++matrix_index) {
+        indexNode(matrix_index);
+    }
+    if (leftover_.node_id < getNumberOfNodes()) {
+        cells_.node_indices[leftover_.node_id] = static_cast<CellIndex>(size_);
+    }
+}
+
+OutPathsIntegerType MazeGraph::connectedEdges(const Location& location) const noexcept {
+    const OutPathsIntegerType out_paths = getRotatedOutPaths(location);
+    OutPathsIntegerType result = 0;
+    for (auto out_path : {OutPaths::North, OutPaths::East, OutPaths::South, OutPaths::West}) {
+        if (out_paths & static_cast<OutPathsIntegerType>(out_path)) {
+            const auto neighbor = location + offsetFromOutPath(out_path);
+            if (isInside(neighbor) && hasOutPath(neighbor, mirrorOutPath(out_path))) {
+                result |= static_cast<OutPathsIntegerType>(out_path);
+            }
+        }
+    }
+    return result;
+}
+
+void MazeGraph::updateConnectedEdges(ExtentType first_row,
+                                     ExtentType end_row,
+                                     ExtentType first_column,
+                                     ExtentType end_column) {
+    first_row = std::max(first_row, 0);
+    end_row = std::min(end_row, extent_);
+    first_column = std::max(first_column, 0);
+    end_column = std::min(end_column, extent_);
+    for (auto row = first_row; row < end_row; ++row) {
+        for (auto column = first_column; column < end_column; ++column) {
+            const auto cell = static_cast<CellIndex>(row * extent_ + column);
+            const OutPathsIntegerType edges = connectedEdges(Location{row, column});
+            cells_.connected_edges[cell] = edges;
+        }
+    }
+}
+
+void MazeGraph::updateConnectedEdgesAround(const Location& location) {
+    const auto row = location.getRow();
+    const auto column = location.getColumn();
+    updateConnectedEdges(row - 1, row + 2, column - 1, column + 2);
+}
+
+Location MazeGraph::locationOfMatrixIndex(SizeType matrix_index) const noexcept {
+    // at least one of the two offsets is zero, cf. class documentation
+    const auto matrix_row = static_cast<IndexType>(matrix_index / extent_);
+    const auto matrix_column = static_cast<IndexType>(matrix_index % extent_);
+    const auto row = (matrix_row + cells_.column_offsets[matrix_column]) % extent_;
+    const auto column = (matrix_column + cells_.row_offsets[matrix_row]) % extent_;
+    return Location{row, column};
+}
+
+zobrist::HashType MazeGraph::nodeKey(const Location& location) const noexcept {
+    const SizeType matrix_index = matrixIndex(location);
+    return zobrist::nodeKey(
+        layout_->toCellIndex(location), cells_.node_ids[matrix_index], cells_.tiles[matrix_index] >> 4);
+}
+
+zobrist::HashType MazeGraph::leftoverKey() const noexcept {
+    return zobrist::nodeKey(static_cast<uint32_t>(size_),
+                            leftover_.node_id,
+                            static_cast<RotationDegreeIntegerType>(leftover_.rotation));
+}
+
+void MazeGraph::toggleLineKeys(const Location& shift_location) noexcept {
+    const OffsetType offset = getOffsetByShiftLocation(shift_location, extent_);
+    for (auto position = 0; position < extent_; ++position) {
+        const Location location = 0 != offset.row_offset ? Location{position, shift_location.getColumn()}
+                                                          : Location{shift_location.getRow(), position};
+        toggleKey(nodeKey(location));
+    }
+}
+
+template <typename KeyFunction>
+std::array<zobrist::HashType, 4> MazeGraph::computeHashesAfterShift(const Location& location,
+                                                                    zobrist::HashType hash,
+                                                                    KeyFunction key_function) const noexcept {
+    const OffsetType offset = getOffsetByShiftLocation(location, extent_);
+    hash ^= key_function(leftoverKey());
+    for (auto position = 0; position < extent_; ++position) {
+        const Location old_location = 0 != offset.row_offset ? Location{position, location.getColumn()}
+                                                              : Location{location.getRow(), position};
+        const Location new_location = translateLocationByShift(old_location, location, extent_);
+        // The node which is pushed out becomes the leftover.
+        const auto new_cell = new_location == location ? static_cast<uint32_t>(size_)
+                                                       : static_cast<uint32_t>(layout_->toCellIndex(new_location));
+        const SizeType matrix_index = matrixIndex(old_location);
+        const auto new_key = zobrist::nodeKey(new_cell, cells_.node_ids[matrix_index], cells_.tiles[matrix_index] >> 4);
+        hash ^= key_function(nodeKey(old_location)) ^ key_function(new_key);
+    }
+    std::array<zobrist::HashType, 4> hashes;
+    for (RotationDegreeIntegerType rotation = 0; rotation < hashes.size(); ++rotation) {
+        hashes[rotation] =
+            hash ^ key_function(zobrist::nodeKey(layout_->toCellIndex(location), leftover_.node_id, rotation));
+    }
+    return hashes;
+}
+
+std::array<zobrist::HashType, 4> MazeGraph::hashesAfterShift(const Location& location) const noexcept {
+    return computeHashesAfterShift(location, hash_, [](zobrist::HashType key) { return key; });
+}
+
+std::array<zobrist::HashType, 4> MazeGraph::verificationHashesAfterShift(const Location& location) const noexcept {
+    return computeHashesAfterShift(
+        location, verification_hash_, [](zobrist::HashType key) { return zobrist::verificationKey(key); });
+}
+
+void MazeGraph::computeHashes() noexcept {
+    hash_ = 0;
+    verification_hash_ = 0;
+    toggleKey(leftoverKey());
+    for (auto row = 0; row < extent_; ++row) {
+        for (auto column = 0; column < extent_; ++column) {
+            toggleKey(nodeKey(Location{row, column}));
+        }
+    }
+}
+
 MazeGraph::NeighborIterator MazeGraph::neighbors(const Location& location) const {
-    return MazeGraph::NeighborIterator(OutPaths::North, *this, location, getNode(location));
+    return MazeGraph::NeighborIterator(OutPaths::North, location, getConnectedEdges(location));
 }
 
 MazeGraph::SizeType MazeGraph::getNumberOfNodes() const noexcept {
@@ -124,16 +348,84 @@ MazeGraph::ExtentType MazeGraph::getExtent() const noexcept {
 
 void MazeGraph::shift(const Location& location, RotationDegreeType leftover_rotation) {
     const OffsetType offset = getOffsetByShiftLocation(location, extent_);
-    auto to_location = opposingShiftLocation(location, extent_);
-    const Node updated_leftover = getNode(to_location);
-    for (auto i = 0; i < extent_ - 1; ++i) {
-        auto from_location = to_location - offset;
-        getNode(to_location) = getNode(from_location);
-        to_location = from_location;
+    toggleLineKeys(location);
+    toggleKey(leftoverKey());
+    if (0 != offset.row_offset) {
+        normalizeRows();
+        rotateOffset(cells_.column_offsets[location.getColumn()], offset.row_offset, extent_, num_rotated_columns_);
+    } else {
+        normalizeColumns();
+        rotateOffset(cells_.row_offsets[location.getRow()], offset.column_offset, extent_, num_rotated_rows_);
     }
+    // After rotating the line, the node which is pushed out occupies the inserted location.
     leftover_.rotation = leftover_rotation;
-    getNode(to_location) = leftover_;
-    leftover_ = updated_leftover;
+    const SizeType inserted_index = matrixIndex(location);
+    const Node pushed_out = nodeAt(inserted_index);
+    storeNode(inserted_index, leftover_);
+    leftover_ = pushed_out;
+    indexNode(inserted_index);
+    if (leftover_.node_id < getNumberOfNodes()) {
+        cells_.node_indices[leftover_.node_id] = static_cast<CellIndex>(size_);
+    }
+    toggleLineKeys(location);
+    toggleKey(leftoverKey());
+    // Only the shifted line and the edges towards its neighboring lines have changed.
+    if (0 != offset.row_offset) {
+        updateConnectedEdges(0, extent_, location.getColumn() - 1, location.getColumn() + 2);
+    } else {
+        updateConnectedEdges(location.getRow() - 1, location.getRow() + 2, 0, extent_);
+    }
+}
+
+ShiftUndoRecord MazeGraph::applyShift(const Location& location, RotationDegreeType leftover_rotation) {
+    const RotationDegreeType previous_leftover_rotation = leftover_.rotation;
+    shift(location, leftover_rotation);
+    return ShiftUndoRecord{location, leftover_.rotation, previous_leftover_rotation};
+}
+
+void MazeGraph::undo(const ShiftUndoRecord& record) {
+    shift(opposingShiftLocation(record.shift_location, extent_), record.pushed_out_rotation);
+    toggleKey(leftoverKey());
+    leftover_.rotation = record.leftover_rotation;
+    toggleKey(leftoverKey());
+}
+
+void MazeGraph::normalizeRows() {
+    if (num_rotated_rows_ == 0) {
+        return;
+    }
+    for (auto row = 0; row < extent_; ++row) {
+        if (cells_.row_offsets[row] != 0) {
+            const auto middle = extent_ - cells_.row_offsets[row];
+            auto first_tile = cells_.tiles + row * extent_;
+            std::rotate(first_tile, first_tile + middle, first_tile + extent_);
+            auto first_id = cells_.node_ids + row * extent_;
+            std::rotate(first_id, first_id + middle, first_id + extent_);
+            cells_.row_offsets[row] = 0;
+            for (auto column = 0; column < extent_; ++column) {
+                indexNode(row * extent_ + column);
+            }
+        }
+    }
+    num_rotated_rows_ = 0;
+}
+
+void MazeGraph::normalizeColumns() {
+    if (num_rotated_columns_ == 0) {
+        return;
+    }
+    for (auto column = 0; column < extent_; ++column) {
+        if (cells_.column_offsets[column] != 0) {
+            const auto middle = extent_ - cells_.column_offsets[column];
+            rotateColumn(cells_.tiles + column, extent_, middle);
+            rotateColumn(cells_.node_ids + column, extent_, middle);
+            cells_.column_offsets[column] = 0;
+            for (auto row = 0; row < extent_; ++row) {
+                indexNode(row * extent_ + column);
+            }
+        }
+    }
+    num_rotated_columns_ = 0;
 }
 
 Location MazeGraph::NeighborIterator::operator*() const {
@@ -153,12 +445,9 @@ MazeGraph::NeighborIterator MazeGraph::NeighborIterator::operator++(int) {
 }
 
 void MazeGraph::NeighborIterator::moveToNextNeighbor() {
-
-    const auto rotated_out_paths = rotateOutPaths(node_.out_paths, node_.rotation);
-    const auto node_out_paths = static_cast<OutPathsIntegerType>(rotated_out_paths);
     auto out_path_int = static_cast<OutPathsIntegerType>(current_out_path_);
 
-    while ((out_path_int < sentinel_) && (!(out_path_int & node_out_paths) || !isNeighbor(current_out_path_))) {
+    while ((out_path_int < sentinel_) && !(out_path_int & connected_edges_)) {
         out_path_int <<= 1;
         current_out_path_ = static_cast<OutPaths>(out_path_int);
     }
@@ -169,61 +458,6 @@ bool MazeGraph::NeighborIterator::isAtEnd() const {
     return out_path_int >= sentinel_;
 }
 
-bool MazeGraph::NeighborIterator::isNeighbor(OutPaths out_path) const {
-    const auto potential_location = location_ + offsetFromOutPath(out_path);
-    return graph_.isInside(potential_location) && hasOutPath(graph_.getNode(potential_location), mirrorOutPath(out_path));
-}
-
-Location opposingShiftLocation(const Location& location, MazeGraph::ExtentType extent) noexcept {
-    const auto row = location.getRow();
-    const auto column = location.getColumn();
-    MazeGraph::ExtentType border = extent - 1;
-    if (column == 0) {
-        return Location{row, border};
-    } else if (row == 0) {
-        return Location{border, column};
-    } else if (column == border) {
-        return Location{row, 0};
-    } else if (row == border) {
-        return Location{0, column};
-    }
-    return location;
-}
-
-Location translateLocationByShift(const Location& location,
-                                  const Location& shift_location,
-                                  MazeGraph::ExtentType extent) noexcept {
-    const Location::OffsetType offset = getOffsetByShiftLocation(shift_location, extent);
-    if (0 != offset.row_offset) { // shift in direction N or S
-        if (location.getColumn() == shift_location.getColumn()) {
-            const Location::IndexType row = (location.getRow() + offset.row_offset + extent) % extent;
-            const Location::IndexType column = location.getColumn();
-            return Location{row, column};
-        }
-    } else { // shift in direction E or W
-        if (location.getRow() == shift_location.getRow()) {
-            const Location::IndexType row = location.getRow();
-            const Location::IndexType column = (location.getColumn() + offset.column_offset + extent) % extent;
-            return Location{row, column};
-        }
-    }
-    return location;
-}
-
-Location::OffsetType getOffsetByShiftLocation(const Location& shift_location, MazeGraph::ExtentType extent) noexcept {
-    Location::OffsetType::OffsetValueType row_offset{0}, column_offset{0};
-    if (shift_location.getRow() == 0) {
-        row_offset = 1;
-    } else if (shift_location.getRow() == extent - 1) {
-        row_offset = -1;
-    } else if (shift_location.getColumn() == 0) {
-        column_offset = 1;
-    } else if (shift_location.getColumn() == extent - 1) {
-        column_offset = -1;
-    }
-    return Location::OffsetType{row_offset, column_offset};
-}
-
 } // namespace labyrinth
 
 namespace std {
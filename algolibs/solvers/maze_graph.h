@@ -1,8 +1,13 @@
 #pragma once
 
+#include "cell_layout.h"
 #include "location.h"
+#include "zobrist.h"
 
+#include <array>
+#include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace labyrinth {
@@ -25,9 +30,37 @@ struct Node {
 
 bool hasOutPath(const Node& node, OutPaths out_path);
 
+/// Returns the given out paths rotated clockwise by the given rotation, e.g. North becomes East for a rotation of 90.
+constexpr OutPathsIntegerType rotateOutPaths(OutPathsIntegerType out_paths, RotationDegreeType rotation) noexcept {
+    const auto paths = static_cast<unsigned int>(out_paths & 15u);
+    const auto shift = static_cast<unsigned int>(rotation);
+    return static_cast<OutPathsIntegerType>((paths << shift | paths >> (4 - shift)) & 15u);
+}
+
+/// Contains the information which is required to revert a shift, cf. MazeGraph::applyShift().
+struct ShiftUndoRecord {
+    Location shift_location{-1, -1};
+    // rotation of the node which was pushed out by the shift
+    RotationDegreeType pushed_out_rotation{0};
+    // rotation of the leftover before it was inserted
+    RotationDegreeType leftover_rotation{0};
+};
+
 /// This class models a graph which represents a maze.
 /// To construct such a graph, first construct an empty Graph with a fixed size.
 /// Then set the maze cell at each location. A maze cell is defined by a String over the alphabet {N,S,E,W}.
+///
+/// Each row and each column carries a rotation offset, which relates the logical location of a node to its location
+/// in the node matrix. Shifting a line only changes its offset and swaps one node with the leftover.
+/// As rows and columns cross each other, only the offsets of one orientation may differ from zero at any time.
+/// Before a row is shifted, all rotated columns are written back to the node matrix, and vice versa.
+/// Hence, successive shifts of lines with the same orientation update the node matrix in constant time, whereas a shift
+/// perpendicular to rotated lines costs O(extent) per rotated line, i.e. up to O(extent^2) if all lines are rotated.
+/// In both cases, the connected edges of the shifted line and its neighboring lines are recomputed in O(extent).
+///
+/// The node matrix is stored as a struct of arrays: Out paths and rotation of each node are packed into one byte,
+/// and the node identifiers are kept in a separate array, which is only accessed when the identity of a node is
+/// queried.
 class MazeGraph {
 private:
     class NeighborIterator;
@@ -50,20 +83,81 @@ public:
 
     void setLeftoverOutPaths(OutPaths out_paths);
 
-    const Node& getNode(const Location& location) const {
-        return node_matrix_[location.getRow() * extent_ + location.getColumn()];
+    Node getNode(const Location& location) const { return nodeAt(matrixIndex(location)); }
+
+    NodeId getNodeId(const Location& location) const noexcept { return cells_.node_ids[matrixIndex(location)]; }
+
+    /// Sets the rotation of the node at the given location.
+    void setRotation(const Location& location, RotationDegreeType rotation);
+
+    /// Returns the out paths of the node at the given location, with its rotation already applied.
+    OutPathsIntegerType getRotatedOutPaths(const Location& location) const noexcept {
+        return rotatedOutPaths(cells_.tiles[matrixIndex(location)]);
+    }
+
+    /// Checks if the node at the given location has a (rotated) out path in the given direction.
+    bool hasOutPath(const Location& location, OutPaths out_path) const noexcept {
+        return getRotatedOutPaths(location) & static_cast<OutPathsIntegerType>(out_path);
     }
 
-    Node& getNode(const Location& location) { return node_matrix_[location.getRow() * extent_ + location.getColumn()]; }
+    /// Returns the out paths of the node at the given location which lead to an inside neighbor with an opposing
+    /// out path, i.e. the edges of the graph at this location.
+    OutPathsIntegerType getConnectedEdges(const Location& location) const noexcept {
+        return cells_.connected_edges[layout_->toCellIndex(location)];
+    }
+
+    OutPathsIntegerType getConnectedEdges(CellIndex cell) const noexcept { return cells_.connected_edges[cell]; }
+
+    /// Returns the neighboring cell in the direction of the given out path. Expects the neighbor to be inside the maze,
+    /// e.g. because the out path is a connected edge.
+    CellIndex neighborCell(CellIndex cell, OutPaths out_path) const noexcept {
+        switch (out_path) {
+        case OutPaths::North:
+            return static_cast<CellIndex>(cell - extent_);
+        case OutPaths::East:
+            return static_cast<CellIndex>(cell + 1);
+        case OutPaths::South:
+            return static_cast<CellIndex>(cell + extent_);
+        default:
+            return static_cast<CellIndex>(cell - 1);
+        }
+    }
+
+    const CellLayout& getLayout() const noexcept { return *layout_; }
+
+    /// Returns the Zobrist hash of the maze, which covers the node identifier and rotation at each location
+    /// and of the leftover. Out paths are not covered, as they are determined by the node identifiers.
+    /// The hash is updated incrementally by shifts and rotation changes, cf. zobrist.h.
+    zobrist::HashType getHash() const noexcept { return hash_; }
+
+    /// Returns the hashes which the maze would have after the given shift, without carrying it out.
+    /// The hashes are indexed by the rotation of the inserted leftover.
+    std::array<zobrist::HashType, 4> hashesAfterShift(const Location& location) const noexcept;
+
+    /// Returns a second hash of the maze, which consists of the verification keys of the components of getHash().
+    /// It tells apart mazes whose hashes collide, cf. zobrist::verificationKey().
+    zobrist::HashType getVerificationHash() const noexcept { return verification_hash_; }
+
+    /// Returns the verification hashes which the maze would have after the given shift, cf. hashesAfterShift().
+    std::array<zobrist::HashType, 4> verificationHashesAfterShift(const Location& location) const noexcept;
 
     const Node& getLeftover() const { return leftover_; }
 
     void shift(const Location& location, RotationDegreeType leftover_rotation);
 
+    /// Shifts the maze, and returns a record which allows to revert the shift with undo().
+    ShiftUndoRecord applyShift(const Location& location, RotationDegreeType leftover_rotation);
+
+    /// Reverts a shift carried out by applyShift(), including rotations of the inserted node set in the meantime.
+    /// Multiple shifts have to be reverted in reverse order.
+    void undo(const ShiftUndoRecord& record);
+
     const std::vector<Location>& getShiftLocations() const noexcept { return shift_locations_; };
 
     /// Returns the location of a given node identifier.
     /// If the location cannot be found in the maze, the second parameter is returned.
+    /// Runs in constant time for node identifiers smaller than the number of nodes,
+    /// other identifiers require a linear search.
     Location getLocation(NodeId node_id, const Location& leftover_location) const;
 
     /// returns an iterator over neighboring locations.
@@ -78,11 +172,10 @@ private:
 
     class NeighborIterator {
     public:
-        NeighborIterator(OutPaths current_out_path, const MazeGraph& graph, const Location& location, const Node& node) :
-            current_out_path_{current_out_path}, graph_{graph}, location_{location}, node_{node} {
+        NeighborIterator(OutPaths current_out_path, const Location& location, OutPathsIntegerType connected_edges) :
+            current_out_path_{current_out_path}, location_{location}, connected_edges_{connected_edges} {
             moveToNextNeighbor();
         };
-        static NeighborIterator begin(const MazeGraph& graph, const Location& location, const Node& node);
 
         Location operator*() const;
 
@@ -96,33 +189,229 @@ private:
 
         void moveToNextNeighbor();
 
-        bool isNeighbor(OutPaths out_path) const;
-
         OutPaths current_out_path_;
-        const MazeGraph& graph_;
         const Location location_;
-        const Node& node_;
+        const OutPathsIntegerType connected_edges_;
     };
 
+    using IndexType = Location::IndexType;
+
+    /// Out paths in the lower four bits, rotation in the two bits above.
+    using TileType = uint8_t;
+
+    static constexpr TileType toTile(OutPaths out_paths, RotationDegreeType rotation) noexcept {
+        return static_cast<TileType>(static_cast<OutPathsIntegerType>(out_paths) |
+                                     (static_cast<RotationDegreeIntegerType>(rotation) << 4));
+    }
+
+    static constexpr OutPathsIntegerType rotatedOutPaths(TileType tile) noexcept {
+        return rotateOutPaths(tile & 15u, static_cast<RotationDegreeType>(tile >> 4));
+    }
+
+    SizeType matrixIndex(const Location& location) const noexcept {
+        // at least one of the two offsets is zero, cf. class documentation
+        auto row = location.getRow() - cells_.column_offsets[location.getColumn()];
+        if (row < 0) {
+            row += extent_;
+        }
+        auto column = location.getColumn() - cells_.row_offsets[location.getRow()];
+        if (column < 0) {
+            column += extent_;
+        }
+        return static_cast<SizeType>(row * extent_ + column);
+    }
+
+    void buildNodeIndex();
+
+    void indexNode(SizeType matrix_index) {
+        const NodeId node_id = cells_.node_ids[matrix_index];
+        if (node_id < getNumberOfNodes()) {
+            cells_.node_indices[node_id] = static_cast<CellIndex>(matrix_index);
+        }
+    }
+
+    Node nodeAt(SizeType matrix_index) const noexcept {
+        const TileType tile = cells_.tiles[matrix_index];
+        return Node{cells_.node_ids[matrix_index],
+                    static_cast<OutPaths>(tile & 15u),
+                    static_cast<RotationDegreeType>(tile >> 4)};
+    }
+
+    void storeNode(SizeType matrix_index, const Node& node) noexcept {
+        cells_.node_ids[matrix_index] = node.node_id;
+        cells_.tiles[matrix_index] = toTile(node.out_paths, node.rotation);
+    }
+
+    OutPathsIntegerType connectedEdges(const Location& location) const noexcept;
+
+    /// Recomputes the connected edges of all locations in the given rows and columns (both half-open ranges),
+    /// which are clamped to the maze.
+    void updateConnectedEdges(ExtentType first_row, ExtentType end_row, ExtentType first_column, ExtentType end_column);
+
+    /// Recomputes the connected edges of the given location and its neighbors.
+    void updateConnectedEdgesAround(const Location& location);
+
+    Location locationOfMatrixIndex(SizeType matrix_index) const noexcept;
+
+    zobrist::HashType nodeKey(const Location& location) const noexcept;
+
+    zobrist::HashType leftoverKey() const noexcept;
+
+    /// Toggles the keys of all nodes in the line which is shifted at the given location.
+    void toggleLineKeys(const Location& shift_location) noexcept;
+
+    /// Toggles a key of the hash, and the corresponding key of the verification hash.
+    void toggleKey(zobrist::HashType key) noexcept {
+        hash_ ^= key;
+        verification_hash_ ^= zobrist::verificationKey(key);
+    }
+
+    /// Computes the hashes after a shift from the given hash of the maze, whose keys are obtained from the keys of
+    /// getHash() with the given function.
+    template <typename KeyFunction>
+    std::array<zobrist::HashType, 4> computeHashesAfterShift(const Location& location,
+                                                             zobrist::HashType hash,
+                                                             KeyFunction key_function) const noexcept;
+
+    /// Computes the hash and the verification hash from scratch.
+    void computeHashes() noexcept;
+
+    /// Writes all rotated rows back to the node matrix, in O(extent) per rotated row.
+    void normalizeRows();
+
+    /// Writes all rotated columns back to the node matrix, in O(extent) per rotated column.
+    void normalizeColumns();
+
     bool isInside(const Location& location) const {
         return (location.getRow() >= 0) && (location.getColumn() >= 0) && (location.getRow() < extent_) &&
                (location.getColumn() < extent_);
     }
 
+    /// The arrays of a graph which have one entry per cell, per node, or per line.
+    /// They share a single allocation, so that a copy of a graph allocates and copies one block of memory.
+    class CellArrays {
+    public:
+        /// Creates zero-initialized arrays for a graph with the given number of cells and extent.
+        CellArrays(SizeType num_cells, ExtentType extent);
+        CellArrays(const CellArrays& other);
+        CellArrays(CellArrays&& other) noexcept = default;
+        CellArrays& operator=(const CellArrays& other);
+        CellArrays& operator=(CellArrays&& other) noexcept = default;
+        ~CellArrays() = default;
+
+        // node matrix, cf. class documentation
+        NodeId* node_ids{nullptr};
+        TileType* tiles{nullptr};
+        // inverse of node_ids, with one entry per node: maps node identifiers to their index in the node matrix,
+        // or to the number of cells for the leftover.
+        CellIndex* node_indices{nullptr};
+        // connected edges, row-wise by (logical) location
+        OutPathsIntegerType* connected_edges{nullptr};
+        IndexType* row_offsets{nullptr};
+        IndexType* column_offsets{nullptr};
+
+    private:
+        static size_t bufferSize(SizeType num_cells, ExtentType extent) noexcept;
+
+        /// Places the arrays in the buffer. They are copied from source, or zero-initialized if source is null.
+        void createArrays(const CellArrays* source);
+
+        SizeType num_cells_;
+        ExtentType extent_;
+        std::unique_ptr<unsigned char[]> buffer_;
+    };
+
     SizeType size_;
     ExtentType extent_;
+    std::shared_ptr<const CellLayout> layout_;
     Node leftover_;
-    std::vector<Node> node_matrix_;
+    CellArrays cells_;
+    size_t num_rotated_rows_{0};
+    size_t num_rotated_columns_{0};
     std::vector<Location> shift_locations_;
+    zobrist::HashType hash_{0};
+    zobrist::HashType verification_hash_{0};
 };
 
-Location::OffsetType getOffsetByShiftLocation(const Location& shift_location, MazeGraph::ExtentType extent) noexcept;
+constexpr Location::OffsetType getOffsetByShiftLocation(const Location& shift_location,
+                                                        MazeGraph::ExtentType extent) noexcept {
+    Location::OffsetType::OffsetValueType row_offset{0}, column_offset{0};
+    if (shift_location.getRow() == 0) {
+        row_offset = 1;
+    } else if (shift_location.getRow() == extent - 1) {
+        row_offset = -1;
+    } else if (shift_location.getColumn() == 0) {
+        column_offset = 1;
+    } else if (shift_location.getColumn() == extent - 1) {
+        column_offset = -1;
+    }
+    return Location::OffsetType{row_offset, column_offset};
+}
+
+constexpr Location opposingShiftLocation(const Location& location, MazeGraph::ExtentType extent) noexcept {
+    const auto row = location.getRow();
+    const auto column = location.getColumn();
+    const MazeGraph::ExtentType border = extent - 1;
+    if (column == 0) {
+        return Location{row, border};
+    } else if (row == 0) {
+        return Location{border, column};
+    } else if (column == border) {
+        return Location{row, 0};
+    } else if (row == border) {
+        return Location{0, column};
+    }
+    return location;
+}
+
+constexpr Location translateLocationByShift(const Location& location,
+                                            const Location& shift_location,
+                                            MazeGraph::ExtentType extent) noexcept {
+    const Location::OffsetType offset = getOffsetByShiftLocation(shift_location, extent);
+    if (0 != offset.row_offset) { // shift in direction N or S
+        if (location.getColumn() == shift_location.getColumn()) {
+            const Location::IndexType row = (location.getRow() + offset.row_offset + extent) % extent;
+            const Location::IndexType column = location.getColumn();
+            return Location{row, column};
+        }
+    } else { // shift in direction E or W
+        if (location.getRow() == shift_location.getRow()) {
+            const Location::IndexType row = location.getRow();
+            const Location::IndexType column = (location.getColumn() + offset.column_offset + extent) % extent;
+            return Location{row, column};
+        }
+    }
+    return location;
+}
 
-Location opposingShiftLocation(const Location& location, MazeGraph::ExtentType extent) noexcept;
+/// Reverts translateLocationByShift(), i.e. returns the location before the given shift.
+constexpr Location revertTranslationByShift(const Location& location,
+                                            const Location& shift_location,
+                                            MazeGraph::ExtentType extent) noexcept {
+    return translateLocationByShift(location, opposingShiftLocation(shift_location, extent), extent);
+}
 
-Location translateLocationByShift(const Location& location,
-                                  const Location& shift_location,
-                                  MazeGraph::ExtentType extent) noexcept;
+template <MazeGraph::ExtentType Extent>
+using StaticExtent = std::integral_constant<MazeGraph::ExtentType, Extent>;
+
+/// Calls function with the extent as compile-time constant (a StaticExtent) for the common maze sizes 7, 9, and 11,
+/// and with the plain runtime extent otherwise.
+/// This allows writing a loop over the maze once, and to let the compiler unroll it for the common sizes.
+/// Only the MazeBitBoard kernels are specialized this way. MazeGraph and the solvers keep the runtime extent, and of
+/// the solvers only the TurnLowerBound of the informed search calls these kernels.
+template <typename Function>
+decltype(auto) dispatchExtent(MazeGraph::ExtentType extent, Function&& function) {
+    switch (extent) {
+    case 7:
+        return function(StaticExtent<7>{});
+    case 9:
+        return function(StaticExtent<9>{});
+    case 11:
+        return function(StaticExtent<11>{});
+    default:
+        return function(extent);
+    }
+}
 
 } // namespace labyrinth
 
@@ -10,6 +10,7 @@
 #include <list>
 #include <memory>
 #include <optional>
+#include <vector>
 
 /**
  * The minimax algorithm searches for the optimal action to play in a two-player zero-sum game.
@@ -31,138 +32,100 @@ namespace minimax {
 
 namespace { // anonymous namespace for file-internal linkage
 
-OutPaths combineOutPaths(OutPaths out_paths1, OutPaths out_paths2) {
-    return static_cast<OutPaths>(static_cast<OutPathsIntegerType>(out_paths1) |
-                                 static_cast<OutPathsIntegerType>(out_paths2));
-}
-
-RotationDegreeType determineMaxRotation(OutPaths out_paths) {
-    auto north_south = combineOutPaths(OutPaths::North, OutPaths::South);
-    auto east_west = combineOutPaths(OutPaths::East, OutPaths::West);
-    if (out_paths == north_south || out_paths == east_west) {
-        return RotationDegreeType::_90;
-    } else {
-        return RotationDegreeType::_270;
-    }
-}
-
-
 /**
  * Iterator for children of a node.
  * 
- * Computes all possible shifts and moves. The moves are computed lazily.
+ * Computes the possible moves of all shifts at once, cf. reachable::allChildrenReachability().
+ * The result is written to the given ChildrenReachability, which is reused by all iterators at the same depth of the
+ * game tree, so that its buffers are only allocated once. The sources buffer is only used during construction.
  * The iterator alters the maze state by applying and undoing the current shift action.
  */
 class ChildIterator {
 // Invariant: either the graph is in a shifted state, or is_at_end_ is true
 public:
-    explicit ChildIterator(const GameTreeNode& parent) :
+    explicit ChildIterator(const GameTreeNode& parent,
+                           reachable::ChildrenReachability& children,
+                           std::vector<CellIndex>& sources) :
         parent_{parent},
         graph_{parent.getGraph()},
-        player_location_{parent.getPlayerLocation()},
-        invalid_shift_location_{opposingShiftLocation(parent_.getPreviousShiftLocation(), graph_.getExtent())},
-        is_at_end_{false},
-        current_rotation_{0},
-        current_shift_location_{graph_.getShiftLocations().begin()} {
-        skipInvalidShiftLocation();
-        shift();
-        initPossibleMoves();
+        layout_{graph_.getLayout()},
+        children_{children},
+        child_index_{0} {
+        sources.assign(1, layout_.toCellIndex(parent.getPlayerLocation()));
+        children_.compute(graph_, sources, parent_.getPreviousShiftLocation());
+        is_at_end_ = children_.getNumberOfChildren() == 0;
+        if (!is_at_end_) {
+            shift();
+            initPossibleMoves();
+        }
     }
 
     ~ChildIterator() {
         if(!is_at_end_) {
-            undoShift();
+            graph_.undo(undo_record_);
         }
     }
 
     PlayerAction getPlayerAction() const {
-        return PlayerAction{ShiftAction{*current_shift_location_, current_rotation_}, *current_move_location_};
+        const auto& child = children_.getChild(child_index_);
+        return PlayerAction{ShiftAction{child.shift_location, child.rotation},
+                            layout_.toLocation(current_move_location_->reached_cell)};
     }
 
     GameTreeNode createGameTreeNode() const {
+        const Location& shift_location = children_.getChild(child_index_).shift_location;
         auto new_opponent_location =
-            translateLocationByShift(parent_.getOpponentLocation(), *current_shift_location_, graph_.getExtent());
-        return GameTreeNode{graph_, new_opponent_location, *current_move_location_, *current_shift_location_};
+            translateLocationByShift(parent_.getOpponentLocation(), shift_location, graph_.getExtent());
+        return GameTreeNode{
+            graph_, new_opponent_location, layout_.toLocation(current_move_location_->reached_cell), shift_location};
     }
 
     bool isAtEnd() const { return is_at_end_; }
 
     ChildIterator& operator++() {
         ++current_move_location_;
-        if (current_move_location_ == possible_move_locations_.end()) {
-            nextShift();
+        if (current_move_location_ == children_.reachedCellsEnd(child_index_)) {
+            nextChild();
         }
         return *this;
     }
 
-    ChildIterator operator++(int) {
-        auto result = ChildIterator(*this);
-        ++(*this);
-        return result;
-    }
-
 private:
-    void nextShift() {
+    void nextChild() {
         // expects the graph to be (still) shifted.
         // At the end, the graph is either (again) shifted, or it is unshifted and is_at_end is true
-        auto max_rotation = determineMaxRotation(graph_.getNode(*current_shift_location_).out_paths);
-        if (current_rotation_ < max_rotation) {
-            current_rotation_ = nextRotation(current_rotation_);
-            graph_.getNode(*current_shift_location_).rotation = current_rotation_;
+        const Location previous_shift_location = children_.getChild(child_index_).shift_location;
+        ++child_index_;
+        if (child_index_ == children_.getNumberOfChildren()) {
+            graph_.undo(undo_record_);
+            is_at_end_ = true;
+            return;
+        }
+        const auto& child = children_.getChild(child_index_);
+        if (child.shift_location == previous_shift_location) {
+            graph_.setRotation(child.shift_location, child.rotation);
         } else {
-            undoShift();
-            current_rotation_ = RotationDegreeType::_0;
-            ++current_shift_location_;
-            if (current_shift_location_ != graph_.getShiftLocations().end()) {
-                skipInvalidShiftLocation();
-            }
-            if (current_shift_location_ == graph_.getShiftLocations().end()) {
-                is_at_end_ = true;
-            } else {
-                shift();
-            }
+            graph_.undo(undo_record_);
+            shift();
         }
         initPossibleMoves();
     }
 
-    void skipInvalidShiftLocation() {
-        if (invalid_shift_location_ == *current_shift_location_) {
-            ++current_shift_location_;
-        }
-    }
-
     void shift() {
-        graph_.shift(*current_shift_location_, current_rotation_);
-        pushed_out_rotation_ = graph_.getLeftover().rotation;
-        player_location_ = translateLocationByShift(player_location_, *current_shift_location_, graph_.getExtent());
+        const auto& child = children_.getChild(child_index_);
+        undo_record_ = graph_.applyShift(child.shift_location, child.rotation);
     }
 
-    void undoShift() {
-        auto opposing_shift_location = opposingShiftLocation(*current_shift_location_, graph_.getExtent());
-        graph_.shift(opposing_shift_location, pushed_out_rotation_);
-        player_location_ = translateLocationByShift(player_location_, opposing_shift_location, graph_.getExtent());
-    }
-
-    void initPossibleMoves() {
-        // expects the graph to already be shifted
-        if (!is_at_end_) {
-            possible_move_locations_ = reachable::reachableLocations(graph_, player_location_);
-        } else {
-            possible_move_locations_.resize(0);
-        }
-        current_move_location_ = possible_move_locations_.begin();
-    }
+    void initPossibleMoves() { current_move_location_ = children_.reachedCellsBegin(child_index_); }
 
     const GameTreeNode& parent_;
     MazeGraph& graph_;
-    Location player_location_;
-    const Location invalid_shift_location_;
+    const CellLayout& layout_;
+    reachable::ChildrenReachability& children_;
+    size_t child_index_;
     bool is_at_end_;
-    RotationDegreeType current_rotation_;
-    RotationDegreeType pushed_out_rotation_;
-    std::vector<Location>::const_iterator current_shift_location_;
-    std::vector<Location> possible_move_locations_;
-    std::vector<Location>::const_iterator current_move_location_;
+    ShiftUndoRecord undo_record_;
+    reachable::ChildrenReachability::ReachedCellIterator current_move_location_;
 };
 
 /**
@@ -182,6 +145,7 @@ public:
         best_action_{error_player_action} {}
 
     MinimaxResult runMinimax() {
+        children_by_depth_.resize(max_depth_);
         MazeGraph graph_copy{solver_instance_.graph};
         GameTreeNode root{graph_copy,
                           solver_instance_.player_location,
@@ -206,7 +170,9 @@ private:
         if (depth == max_depth_ or is_terminal) {
             return evaluator_->evaluate(node);
         }
-        for (ChildIterator child_iterator{node}; !child_iterator.isAtEnd(); ++child_iterator) {
+        for (ChildIterator child_iterator{node, children_by_depth_[depth], sources_};
+             !child_iterator.isAtEnd();
+             ++child_iterator) {
             auto child_node = child_iterator.createGameTreeNode();
             auto negamax_value = -negamax(child_node, -beta, -alpha, depth + 1);
             if (negamax_value >= beta) {
@@ -230,6 +196,9 @@ private:
     const SolverInstance& solver_instance_;
     size_t max_depth_;
     PlayerAction best_action_;
+    // The iterators of all depths on the current path are alive at once, so each depth has its own buffers.
+    std::vector<reachable::ChildrenReachability> children_by_depth_;
+    std::vector<CellIndex> sources_;
 };
 
 /**
@@ -0,0 +1,233 @@
+#include "row_masks.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)) && \
+    !defined(__EMSCRIPTEN__)
+#define LABYRINTH_ROW_MASKS_X86
+#include <immintrin.h>
+#endif
+
+namespace labyrinth {
+
+namespace { // anonymous namespace for file-internal linkage
+
+using RowType = RowMaskBoard::RowType;
+using Rows = RowMaskBoard::Rows;
+
+RowType saturateRow(RowType row, RowType east_links) noexcept {
+    for (RowType grown = row | ((row & east_links) << 1) | ((row >> 1) & east_links); grown != row;
+         grown = row | ((row & east_links) << 1) | ((row >> 1) & east_links)) {
+        row = grown;
+    }
+    return row;
+}
+
+Rows floodFillScalar(Rows reached, const Rows& east_links, const Rows& south_links, size_t extent) noexcept {
+    // Sweeps over the rows alternately downwards and upwards, so that paths are followed in both directions.
+    bool has_changed = true;
+    while (has_changed) {
+        has_changed = false;
+        for (size_t step = 0; step < 2 * extent; ++step) {
+            const size_t row = step < extent ? step : 2 * extent - 1 - step;
+            RowType cells = reached[row];
+            if (row > 0) {
+                cells |= reached[row - 1] & south_links[row - 1];
+            }
+            if (row + 1 < extent) {
+                cells |= reached[row + 1] & south_links[row];
+            }
+            cells = saturateRow(cells, east_links[row]);
+            has_changed |= cells != reached[row];
+            reached[row] = cells;
+        }
+    }
+    return reached;
+}
+
+#ifdef LABYRINTH_ROW_MASKS_X86
+
+constexpr size_t num_registers = 4;
+
+__attribute__((target("avx2"))) Rows floodFillAvx2(const Rows& cells,
+                                                   const Rows& east_links,
+                                                   const Rows& south_links) noexcept {
+    __m256i reached[num_registers];
+    __m256i east[num_registers];
+    __m256i south[num_registers];
+    for (size_t i = 0; i < num_registers; ++i) {
+        reached[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cells.data() + 8 * i));
+        east[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(east_links.data() + 8 * i));
+        south[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(south_links.data() + 8 * i));
+    }
+    // Lane permutations which move each row to the next and to the previous row, respectively.
+    const __m256i to_next_row = _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6);
+    const __m256i to_previous_row = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    const __m256i zero = _mm256_setzero_si256();
+    bool has_changed = true;
+    while (has_changed) {
+        // saturate all rows horizontally
+        for (size_t i = 0; i < num_registers; ++i) {
+            __m256i row = reached[i];
+            __m256i grown;
+            while (true) {
+                grown = _mm256_or_si256(row,
+                                        _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(row, east[i]), 1),
+                                                        _mm256_and_si256(_mm256_srli_epi32(row, 1), east[i])));
+                if (_mm256_testc_si256(row, grown)) {
+                    break;
+                }
+                row = grown;
+            }
+            reached[i] = row;
+        }
+        // one step along the columns
+        __m256i from_above[num_registers];
+        __m256i from_below[num_registers];
+        for (size_t i = 0; i < num_registers; ++i) {
+            from_above[i] = _mm256_permutevar8x32_epi32(_mm256_and_si256(reached[i], south[i]), to_next_row);
+            from_below[i] = _mm256_permutevar8x32_epi32(reached[i], to_previous_row);
+        }
+        has_changed = false;
+        for (size_t i = 0; i < num_registers; ++i) {
+            // The first (last) lane is taken from the previous (next) register.
+            const __m256i previous = i > 0 ? from_above[i - 1] : zero;
+            const __m256i next = i + 1 < num_registers ? from_below[i + 1] : zero;
+            const __m256i above = _mm256_blend_epi32(from_above[i], previous, 0x01);
+            const __m256i below = _mm256_and_si256(_mm256_blend_epi32(from_below[i], next, 0x80), south[i]);
+            const __m256i grown = _mm256_or_si256(reached[i], _mm256_or_si256(above, below));
+            has_changed |= !_mm256_testc_si256(reached[i], grown);
+            reached[i] = grown;
+        }
+    }
+    Rows result;
+    for (size_t i = 0; i < num_registers; ++i) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(result.data() + 8 * i), reached[i]);
+    }
+    return result;
+}
+
+constexpr size_t num_sse_registers = 8;
+
+__attribute__((target("sse4.1"))) Rows floodFillSse41(const Rows& cells,
+                                                      const Rows& east_links,
+                                                      const Rows& south_links) noexcept {
+    __m128i reached[num_sse_registers];
+    __m128i east[num_sse_registers];
+    __m128i south[num_sse_registers];
+    for (size_t i = 0; i < num_sse_registers; ++i) {
+        reached[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells.data() + 4 * i));
+        east[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(east_links.data() + 4 * i));
+        south[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(south_links.data() + 4 * i));
+    }
+    const __m128i zero = _mm_setzero_si128();
+    bool has_changed = true;
+    while (has_changed) {
+        // saturate all rows horizontally
+        for (size_t i = 0; i < num_sse_registers; ++i) {
+            __m128i row = reached[i];
+            __m128i grown;
+            while (true) {
+                grown = _mm_or_si128(row,
+                                     _mm_or_si128(_mm_slli_epi32(_mm_and_si128(row, east[i]), 1),
+                                                  _mm_and_si128(_mm_srli_epi32(row, 1), east[i])));
+                if (_mm_testc_si128(row, grown)) {
+                    break;
+                }
+                row = grown;
+            }
+            reached[i] = row;
+        }
+        // one step along the columns
+        __m128i to_next_row[num_sse_registers];
+        for (size_t i = 0; i < num_sse_registers; ++i) {
+            to_next_row[i] = _mm_and_si128(reached[i], south[i]);
+        }
+        has_changed = false;
+        for (size_t i = 0; i < num_sse_registers; ++i) {
+            // Rows are moved across registers by concatenating neighboring registers, and shifting by one lane.
+            const __m128i previous = i > 0 ? to_next_row[i - 1] : zero;
+            const __m128i next = i + 1 < num_sse_registers ? reached[i + 1] : zero;
+            const __m128i above = _mm_alignr_epi8(to_next_row[i], previous, 12);
+            const __m128i below = _mm_and_si128(_mm_alignr_epi8(next, reached[i], 4), south[i]);
+            const __m128i grown = _mm_or_si128(reached[i], _mm_or_si128(above, below));
+            has_changed |= !_mm_testc_si128(reached[i], grown);
+            reached[i] = grown;
+        }
+    }
+    Rows result;
+    for (size_t i = 0; i < num_sse_registers; ++i) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(result.data() + 4 * i), reached[i]);
+    }
+    return result;
+}
+
+#endif
+
+} // anonymous namespace
+
+bool RowMaskBoard::isAvailable(Implementation implementation) noexcept {
+    if (implementation == Implementation::scalar) {
+        return true;
+    }
+#ifdef LABYRINTH_ROW_MASKS_X86
+    static const bool has_sse41 = __builtin_cpu_supports("sse4.1");
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return implementation == Implementation::avx2 ? has_avx2 : has_sse41;
+#else
+    return false;
+#endif
+}
+
+RowMaskBoard::Implementation RowMaskBoard::bestImplementation() noexcept {
+    static const Implementation best_implementation =
+        isAvailable(Implementation::avx2)    ? Implementation::avx2
+        : isAvailable(Implementation::sse41) ? Implementation::sse41
+                                             : Implementation::scalar;
+    return best_implementation;
+}
+
+MazeGraph::ExtentType RowMaskBoard::countTrailingZeros(RowType row) noexcept {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, row);
+    return static_cast<MazeGraph::ExtentType>(index);
+#else
+    return static_cast<MazeGraph::ExtentType>(__builtin_ctz(row));
+#endif
+}
+
+RowMaskBoard::RowMaskBoard(const MazeGraph& graph) : extent_{graph.getExtent()} {
+    const auto east = static_cast<OutPathsIntegerType>(OutPaths::East);
+    const auto south = static_cast<OutPathsIntegerType>(OutPaths::South);
+    CellIndex cell = 0;
+    for (auto row = 0; row < extent_; ++row) {
+        for (auto column = 0; column < extent_; ++column, ++cell) {
+            const auto edges = static_cast<OutPathsIntegerType>(graph.getConnectedEdges(cell));
+            if (edges & east) {
+                east_links_[row] |= RowType{1} << column;
+            }
+            if (edges & south) {
+                south_links_[row] |= RowType{1} << column;
+            }
+        }
+    }
+}
+
+RowMaskBoard::Rows RowMaskBoard::floodFill(const Rows& cells) const noexcept {
+    return floodFill(cells, bestImplementation());
+}
+
+RowMaskBoard::Rows RowMaskBoard::floodFill(const Rows& cells, Implementation implementation) const noexcept {
+#ifdef LABYRINTH_ROW_MASKS_X86
+    if (implementation == Implementation::avx2) {
+        return floodFillAvx2(cells, east_links_, south_links_);
+    }
+    if (implementation == Implementation::sse41) {
+        return floodFillSse41(cells, east_links_, south_links_);
+    }
+#else
+    static_cast<void>(implementation);
+#endif
+    return floodFillScalar(cells, east_links_, south_links_, static_cast<size_t>(extent_));
+}
+
+} // namespace labyrinth
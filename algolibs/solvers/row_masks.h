@@ -0,0 +1,75 @@
+#pragma once
+
+#include "location.h"
+#include "maze_graph.h"
+
+#include <array>
+#include <cstdint>
+
+namespace labyrinth {
+
+/// Alternative representation of a maze for computing reachability with SIMD instructions.
+///
+/// Each row of the maze is stored as a 32-bit mask, in which bit c belongs to column c. For each row, there is one
+/// mask of the cells which are connected to their eastern neighbor, and one of the cells which are connected to their
+/// southern neighbor. The reached cells are grown along the rows until they are saturated, and then by one step
+/// along the columns, until a fixpoint is reached.
+/// With AVX2, eight rows are kept in one vector register, and with SSE4.1 four rows, so that all rows are grown at
+/// once. The implementation is selected at runtime, depending on the features of the CPU. The scalar implementation
+/// is used on all other platforms, e.g. WebAssembly.
+/// Mazes with an extent of up to 32 can be represented.
+class RowMaskBoard {
+public:
+    using RowType = uint32_t;
+    using Rows = std::array<RowType, 32>;
+
+    enum class Implementation { scalar, sse41, avx2 };
+
+    static constexpr MazeGraph::ExtentType max_extent = 32;
+
+    static bool supportsExtent(MazeGraph::ExtentType extent) noexcept { return extent >= 0 && extent <= max_extent; }
+
+    /// Checks if the given implementation has been compiled, and is supported by the CPU.
+    static bool isAvailable(Implementation implementation) noexcept;
+
+    /// Returns the fastest available implementation.
+    static Implementation bestImplementation() noexcept;
+
+    explicit RowMaskBoard(const MazeGraph& graph);
+
+    static Rows singleCell(const Location& location) noexcept {
+        Rows rows{};
+        rows[location.getRow()] = RowType{1} << location.getColumn();
+        return rows;
+    }
+
+    static bool test(const Rows& rows, const Location& location) noexcept {
+        return (rows[location.getRow()] >> location.getColumn()) & 1u;
+    }
+
+    /// Calls function(cell) for each of the given cells, in ascending order of their cell indices.
+    template <typename Function>
+    void forEachCell(const Rows& cells, Function function) const {
+        for (MazeGraph::ExtentType row = 0; row < extent_; ++row) {
+            for (RowType remaining = cells[row]; remaining != 0; remaining &= remaining - 1) {
+                function(static_cast<CellIndex>(row * extent_ + countTrailingZeros(remaining)));
+            }
+        }
+    }
+
+    /// Returns all cells which are connected to at least one of the given cells, with the fastest implementation.
+    Rows floodFill(const Rows& cells) const noexcept;
+
+    /// Same as floodFill(), with the given implementation. Expects the implementation to be available.
+    Rows floodFill(const Rows& cells, Implementation implementation) const noexcept;
+
+private:
+    static MazeGraph::ExtentType countTrailingZeros(RowType row) noexcept;
+
+    MazeGraph::ExtentType extent_;
+    // rows beyond the extent remain empty
+    Rows east_links_{};
+    Rows south_links_{};
+};
+
+} // namespace labyrinth
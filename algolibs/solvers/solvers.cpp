@@ -1,5 +1,19 @@
 #include "solvers.h"
 
+namespace labyrinth {
+
+namespace solvers {
+
+zobrist::HashType hashSolverInstance(const SolverInstance& solver_instance) {
+    return solver_instance.graph.getHash() ^ zobrist::playerKey(solver_instance.player_location, 0) ^
+           zobrist::playerKey(solver_instance.opponent_location, 1) ^
+           zobrist::objectiveKey(solver_instance.objective_id) ^
+           zobrist::previousShiftKey(solver_instance.previous_shift_location);
+}
+
+} // namespace solvers
+} // namespace labyrinth
+
 namespace std {
 std::ostream& operator<<(std::ostream& stream, const labyrinth::solvers::PlayerAction& player_action) {
     stream << "{shift: [" << player_action.shift.location << ", " << player_action.shift.rotation
@@ -29,6 +29,9 @@ struct PlayerAction {
 };
 
 static const PlayerAction error_player_action = PlayerAction{ShiftAction{}, Location{-1, -1}};
+
+/// Returns a Zobrist hash of the maze, the locations of both players, the objective, and the previous shift location.
+zobrist::HashType hashSolverInstance(const SolverInstance& solver_instance);
 } // namespace solvers
 } // namespace labyrinth
 
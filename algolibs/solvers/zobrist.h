@@ -0,0 +1,66 @@
+#pragma once
+
+#include "location.h"
+
+#include <cstdint>
+
+/*
+ * Keys for Zobrist hashing of game states.
+ * A state is hashed by combining the keys of its components with XOR, so that the hash can be updated incrementally
+ * when a component changes. Instead of tables of random numbers, the keys are computed by mixing the components
+ * with the finalizer of splitmix64, which supports arbitrary node identifiers and extents.
+ */
+
+namespace labyrinth {
+
+namespace zobrist {
+
+using HashType = uint64_t;
+
+constexpr HashType mix(HashType value) noexcept {
+    value += 0x9e3779b97f4a7c15ull;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+}
+
+// Each kind of key uses a distinct tag in the upper bits, so that keys of different kinds do not coincide.
+constexpr HashType objective_tag = HashType{0} << 62;
+constexpr HashType node_tag = HashType{1} << 62;
+constexpr HashType player_tag = HashType{2} << 62;
+constexpr HashType shift_tag = HashType{3} << 62;
+
+/// Key of a node with the given identifier and rotation at the given cell. The leftover uses the cell after the last.
+constexpr HashType nodeKey(uint32_t cell, uint32_t node_id, uint8_t rotation) noexcept {
+    return mix(node_tag | (HashType{cell} << 34) | (HashType{node_id} << 2) | (rotation & 3u));
+}
+
+constexpr HashType locationBits(const Location& location) noexcept {
+    return (static_cast<HashType>(static_cast<uint16_t>(location.getRow())) << 16) |
+           static_cast<uint16_t>(location.getColumn());
+}
+
+/// Key of the location of the player with the given index.
+constexpr HashType playerKey(const Location& location, uint32_t player_index) noexcept {
+    return mix(player_tag | (HashType{player_index} << 32) | locationBits(location));
+}
+
+/// Key of the location of the previous shift.
+constexpr HashType previousShiftKey(const Location& location) noexcept {
+    return mix(shift_tag | locationBits(location));
+}
+
+/// Key of the identifier of the objective node.
+constexpr HashType objectiveKey(uint32_t node_id) noexcept {
+    return mix(objective_tag | node_id);
+}
+
+/// Key of a second hash, which verifies the first one. It is derived from the key of the first hash with another
+/// round of mixing, so that two states whose first hashes collide have different second hashes in general.
+constexpr HashType verificationKey(HashType key) noexcept {
+    return mix(key);
+}
+
+} // namespace zobrist
+
+} // namespace labyrinth
@@ -0,0 +1,149 @@
+#include "graphbuilder/text_graph_builder.h"
+#include "solvers/bitboard.h"
+#include "solvers/maze_graph.h"
+#include "util.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace labyrinth;
+using namespace labyrinth::testutils;
+
+namespace {
+std::vector<BitBoard::IndexType> setBits(const BitBoard& bit_board) {
+    std::vector<BitBoard::IndexType> result;
+    bit_board.forEach([&result](BitBoard::IndexType index) { result.push_back(index); });
+    return result;
+}
+} // namespace
+
+TEST(BitBoardTest, forEach_withBitsInBothWords_iteratesInAscendingOrder) {
+    BitBoard bit_board{};
+    bit_board.set(120);
+    bit_board.set(3);
+    bit_board.set(64);
+    bit_board.set(63);
+
+    EXPECT_THAT(setBits(bit_board), testing::ElementsAre(3, 63, 64, 120));
+    EXPECT_EQ(bit_board.count(), 4u);
+}
+
+TEST(BitBoardTest, shiftLeft_acrossWordBoundary_carriesBit) {
+    const BitBoard shifted = BitBoard::singleBit(60) << 9;
+
+    EXPECT_THAT(setBits(shifted), testing::ElementsAre(69));
+}
+
+TEST(BitBoardTest, shiftRight_acrossWordBoundary_carriesBit) {
+    const BitBoard shifted = BitBoard::singleBit(66) >> 11;
+
+    EXPECT_THAT(setBits(shifted), testing::ElementsAre(55));
+}
+
+TEST(BitBoardTest, lowestBits_with121_setsExactly121Bits) {
+    const BitBoard bit_board = BitBoard::lowestBits(121);
+
+    EXPECT_EQ(bit_board.count(), 121u);
+    EXPECT_TRUE(bit_board.test(120));
+    EXPECT_FALSE(bit_board.test(121));
+}
+
+class MazeBitBoardTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const std::vector<std::string> maze{"###|###|#.#|",
+                                            "#..|...|..#|",
+                                            "#.#|#.#|###|",
+                                            "------------",
+                                            "#.#|###|###|",
+                                            "#..|...|...|",
+                                            "#.#|###|###|",
+                                            "------------",
+                                            "#.#|###|###|",
+                                            "#..|#..|...|",
+                                            "###|#.#|#.#|",
+                                            "------------"};
+        graph_ = TextGraphBuilder{}.setMaze(maze).buildGraph();
+        graph_.setLeftoverOutPaths(OutPaths::North);
+    }
+
+    MazeGraph graph_{0};
+};
+
+TEST_F(MazeBitBoardTest, planes_containRotatedOutPaths) {
+    graph_.setRotation(Location{0, 2}, RotationDegreeType::_90);
+    const MazeBitBoard bit_board{graph_};
+
+    // (0, 2) has out paths N and W, which become E and N when rotated by 90°
+    EXPECT_TRUE(bit_board.getPlane(OutPaths::North).test(2));
+    EXPECT_TRUE(bit_board.getPlane(OutPaths::East).test(2));
+    EXPECT_FALSE(bit_board.getPlane(OutPaths::South).test(2));
+    EXPECT_FALSE(bit_board.getPlane(OutPaths::West).test(2));
+}
+
+TEST_F(MazeBitBoardTest, floodFill_fromCorner_reachesComponent) {
+    const MazeBitBoard bit_board{graph_};
+
+    const BitBoard reached = bit_board.floodFill(BitBoard::singleBit(bit_board.toIndex(Location{0, 0})));
+
+    EXPECT_THAT(setBits(reached), testing::ElementsAre(0, 1, 2, 3, 4, 5, 6));
+}
+
+TEST_F(MazeBitBoardTest, floodFill_doesNotWrapAroundRows) {
+    graph_.setOutPaths(Location{1, 2}, getBitmask("E"));
+    graph_.setOutPaths(Location{2, 0}, getBitmask("W"));
+    const MazeBitBoard bit_board{graph_};
+
+    const BitBoard reached = bit_board.floodFill(BitBoard::singleBit(bit_board.toIndex(Location{1, 2})));
+
+    EXPECT_THAT(setBits(reached), testing::ElementsAre(5));
+}
+
+TEST_F(MazeBitBoardTest, floodFill_fromSecondComponent_reachesComponent) {
+    const MazeBitBoard bit_board{graph_};
+
+    const BitBoard reached = bit_board.floodFill(BitBoard::singleBit(bit_board.toIndex(Location{2, 2})));
+
+    EXPECT_THAT(setBits(reached), testing::ElementsAre(7, 8));
+}
+
+TEST_F(MazeBitBoardTest, floodFill_afterOpeningCell_connectsComponents) {
+    MazeBitBoard bit_board{graph_};
+
+    bit_board.openCells(BitBoard::singleBit(bit_board.toIndex(Location{2, 1})));
+    const BitBoard reached = bit_board.floodFill(BitBoard::singleBit(bit_board.toIndex(Location{0, 0})));
+
+    EXPECT_THAT(setBits(reached), testing::ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8));
+}
+
+TEST_F(MazeBitBoardTest, toLocation_isInverseOfToIndex) {
+    const MazeBitBoard bit_board{graph_};
+    for (auto row = 0; row < 3; ++row) {
+        for (auto column = 0; column < 3; ++column) {
+            const Location location{row, column};
+            EXPECT_EQ(bit_board.toLocation(bit_board.toIndex(location)), location);
+        }
+    }
+}
+
+TEST(MazeBitBoardExtentTest, supportsExtent_upTo11) {
+    EXPECT_TRUE(MazeBitBoard::supportsExtent(7));
+    EXPECT_TRUE(MazeBitBoard::supportsExtent(11));
+    EXPECT_FALSE(MazeBitBoard::supportsExtent(13));
+}
+
+TEST(MazeBitBoardExtentTest, floodFill_withExtent11AndOnlyCrosses_reachesAllCells) {
+    MazeGraph graph{11};
+    for (auto row = 0; row < 11; ++row) {
+        for (auto column = 0; column < 11; ++column) {
+            graph.setOutPaths(Location{row, column}, getBitmask("NESW"));
+        }
+    }
+    const MazeBitBoard bit_board{graph};
+
+    const BitBoard reached = bit_board.floodFill(BitBoard::singleBit(bit_board.toIndex(Location{10, 10})));
+
+    EXPECT_EQ(reached, BitBoard::lowestBits(121));
+}
@@ -0,0 +1,85 @@
+#include "solvers/bitsliced.h"
+#include "solvers/graph_algorithms.h"
+#include "solvers/maze_graph.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace labyrinth;
+
+namespace {
+
+OutPathsIntegerType randomOutPaths(unsigned int& seed) {
+    seed = seed * 1103515245u + 12345u;
+    return static_cast<OutPathsIntegerType>((seed >> 16) % 15 + 1);
+}
+
+} // namespace
+
+TEST(BitSlicedMazesTest, floodFill_with64DifferentBoards_agreesWithReachableCells) {
+    for (const int extent : {7, 13}) {
+        MazeGraph graph{extent};
+        unsigned int seed = 11;
+        for (auto row = 0; row < extent; ++row) {
+            for (auto column = 0; column < extent; ++column) {
+                graph.setOutPaths(Location{row, column}, static_cast<OutPaths>(randomOutPaths(seed)));
+            }
+        }
+        const CellLayout& layout = graph.getLayout();
+        BitSlicedMazes sliced_mazes;
+        sliced_mazes.setAllBoards(graph);
+        std::vector<MazeGraph> boards(BitSlicedMazes::max_boards, graph);
+        std::vector<CellIndex> sources;
+        for (size_t board = 0; board < BitSlicedMazes::max_boards; ++board) {
+            for (auto i = 0; i < 3; ++i) {
+                seed = seed * 1103515245u + 12345u;
+                const auto cell = static_cast<CellIndex>((seed >> 8) % layout.getNumberOfCells());
+                const OutPathsIntegerType out_paths = randomOutPaths(seed);
+                boards[board].setOutPaths(layout.toLocation(cell), static_cast<OutPaths>(out_paths));
+                sliced_mazes.setOutPaths(board, cell, out_paths);
+            }
+            sources.push_back(static_cast<CellIndex>(board % layout.getNumberOfCells()));
+            sliced_mazes.addSource(board, sources.back());
+        }
+
+        sliced_mazes.floodFill();
+
+        std::vector<BitSlicedMazes::WordType> bits;
+        for (size_t board = 0; board < BitSlicedMazes::max_boards; ++board) {
+            std::vector<bool> expected(layout.getNumberOfCells(), false);
+            for (CellIndex cell : reachable::reachableCells(boards[board], sources[board])) {
+                expected[cell] = true;
+            }
+            sliced_mazes.getReachedCells(board, bits);
+            for (CellIndex cell = 0; cell < layout.getNumberOfCells(); ++cell) {
+                EXPECT_EQ(sliced_mazes.isReached(board, cell), expected[cell])
+                    << "for board " << board << " at " << layout.toLocation(cell) << " with extent " << extent;
+                EXPECT_EQ(((bits[cell / 64] >> (cell % 64)) & 1u) != 0, expected[cell]);
+            }
+        }
+    }
+}
+
+TEST(BitSlicedMazesTest, floodFill_withSourceAddedAfterwards_growsOnlyNewComponent) {
+    MazeGraph graph{7};
+    for (auto column = 0; column < 7; ++column) {
+        graph.setOutPaths(Location{1, column}, static_cast<OutPaths>(10));
+        graph.setOutPaths(Location{5, column}, static_cast<OutPaths>(10));
+    }
+    const CellLayout& layout = graph.getLayout();
+    BitSlicedMazes sliced_mazes;
+    sliced_mazes.setAllBoards(graph);
+    sliced_mazes.addSource(2, layout.toCellIndex(Location{1, 3}));
+    sliced_mazes.floodFill();
+
+    EXPECT_TRUE(sliced_mazes.isReached(2, layout.toCellIndex(Location{1, 0})));
+    EXPECT_FALSE(sliced_mazes.isReached(2, layout.toCellIndex(Location{5, 0})));
+    EXPECT_FALSE(sliced_mazes.isReached(1, layout.toCellIndex(Location{1, 0})));
+
+    sliced_mazes.addSource(2, layout.toCellIndex(Location{5, 6}));
+    sliced_mazes.floodFill();
+
+    EXPECT_TRUE(sliced_mazes.isReached(2, layout.toCellIndex(Location{5, 0})));
+    EXPECT_FALSE(sliced_mazes.isReached(2, layout.toCellIndex(Location{3, 0})));
+}
@@ -0,0 +1,46 @@
+#include "solvers/cell_layout.h"
+#include "solvers/maze_graph.h"
+
+#include "gtest/gtest.h"
+
+using namespace labyrinth;
+
+TEST(CellLayoutTest, toLocation_isInverseOfToCellIndex) {
+    const CellLayout layout{9};
+    for (auto row = 0; row < 9; ++row) {
+        for (auto column = 0; column < 9; ++column) {
+            const Location location{row, column};
+            EXPECT_EQ(layout.toLocation(layout.toCellIndex(location)), location);
+        }
+    }
+}
+
+TEST(CellLayoutTest, translateByShift_agreesWithTranslateLocationByShift) {
+    const int extent = 7;
+    const CellLayout layout{extent};
+    for (auto pos = 1; pos < extent; pos += 2) {
+        for (const Location& shift_location :
+             {Location{0, pos}, Location{pos, extent - 1}, Location{extent - 1, pos}, Location{pos, 0}}) {
+            const CellIndex shift_cell = layout.toCellIndex(shift_location);
+            for (CellIndex cell = 0; cell < layout.getNumberOfCells(); ++cell) {
+                const Location expected = translateLocationByShift(layout.toLocation(cell), shift_location, extent);
+                EXPECT_EQ(layout.toLocation(layout.translateByShift(cell, shift_cell)), expected)
+                    << "for " << layout.toLocation(cell) << " shifted at " << shift_location;
+            }
+        }
+    }
+}
+
+TEST(CellLayoutTest, translateByShift_withInnerShiftCell_returnsCell) {
+    const CellLayout layout{7};
+
+    EXPECT_EQ(layout.translateByShift(10, layout.toCellIndex(Location{3, 3})), 10);
+}
+
+TEST(CellLayoutTest, translateByShift_withExtent31_fitsIntoCellIndex) {
+    const CellLayout layout{31};
+    const CellIndex shift_cell = layout.toCellIndex(Location{30, 29});
+
+    EXPECT_EQ(layout.translateByShift(layout.toCellIndex(Location{0, 29}), shift_cell),
+              layout.toCellIndex(Location{30, 29}));
+}
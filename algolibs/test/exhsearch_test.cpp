@@ -30,6 +30,19 @@ protected:
         graph_.setLeftoverOutPaths(getBitmask(leftover_out_paths));
     }
 
+    /// Closes all tiles except (4, 0) and (1, 6), which are open to the north. From (4, 0), the objective at (1, 6) is
+    /// reached by pushing it out with the first shift, and inserting it into a parallel line with the second one.
+    void buildClosedMaze() {
+        for (auto row = 0; row < 7; ++row) {
+            for (auto column = 0; column < 7; ++column) {
+                graph_.setOutPaths(Location{row, column}, getBitmask(""));
+            }
+        }
+        graph_.setOutPaths(Location{4, 0}, getBitmask("N"));
+        graph_.setOutPaths(Location{1, 6}, getBitmask("N"));
+        graph_.setLeftoverOutPaths(getBitmask(""));
+    }
+
     MazeGraph graph_{0};
 };
 
@@ -111,9 +124,10 @@ void performTest(MazeGraph& graph,
                  const Location& player_location,
                  NodeId objective_id,
                  size_t expected_depth,
-                 const Location& previous_shift = Location{-1, -1}) {
+                 const Location& previous_shift = Location{-1, -1},
+                 const exh::SearchOptions& options = exh::SearchOptions{}) {
     solvers::SolverInstance solver_instance{graph, player_location, Location{-1, -1}, objective_id, previous_shift};
-    auto actions = exh::findBestActions(solver_instance);
+    auto actions = exh::findBestActionsWithOptions(solver_instance, options).actions;
 
     ASSERT_THAT(actions, testing::SizeIs(testing::Ge(1)));
     EXPECT_TRUE(isCorrectPlayerActionSequence(actions, graph, player_location));
@@ -122,6 +136,16 @@ void performTest(MazeGraph& graph,
     EXPECT_THAT(actions, testing::SizeIs(expected_depth));
 }
 
+void expectSameActions(const std::vector<solvers::PlayerAction>& actions,
+                       const std::vector<solvers::PlayerAction>& expected_actions) {
+    ASSERT_THAT(actions, testing::SizeIs(expected_actions.size()));
+    for (size_t i = 0; i < actions.size(); ++i) {
+        EXPECT_EQ(actions[i].shift.location, expected_actions[i].shift.location);
+        EXPECT_EQ(actions[i].shift.rotation, expected_actions[i].shift.rotation);
+        EXPECT_EQ(actions[i].move_location, expected_actions[i].move_location);
+    }
+}
+
 TEST_F(ExhaustiveSearchTest, d1_direct_path) {
     SCOPED_TRACE("d1_direct_path");
     auto objective_id = graph_.getNode(Location(6, 2)).node_id;
@@ -206,6 +230,237 @@ TEST_F(ExhaustiveSearchTest, withResultOfLengthOneViolatingGivenPreviousShift_sh
     performTest(graph_, player_location, objective_id, 2, Location{0, 3});
 }
 
+TEST_F(ExhaustiveSearchTest, d3_withDuplicateElimination_shouldReturnThreeMoves) {
+    SCOPED_TRACE("d3_withDuplicateElimination_shouldReturnThreeMoves");
+    buildGraph(mazes::difficult_maze, {OutPaths::North, OutPaths::South});
+    auto objective_id = graph_.getNode(Location{1, 1}).node_id;
+    Location player_location{4, 6};
+    exh::SearchOptions options;
+    options.eliminate_duplicates = true;
+
+    performTest(graph_, player_location, objective_id, 3, Location{-1, -1}, options);
+}
+
+TEST_F(ExhaustiveSearchTest, withDuplicateElimination_andPreviousShift_shouldReturnTwoMoves) {
+    SCOPED_TRACE("withDuplicateElimination_andPreviousShift_shouldReturnTwoMoves");
+    buildGraph(mazes::difficult_maze, {OutPaths::North, OutPaths::South});
+    auto objective_id = graph_.getLeftover().node_id;
+    Location player_location{6, 2};
+    exh::SearchOptions options;
+    options.eliminate_duplicates = true;
+
+    performTest(graph_, player_location, objective_id, 2, Location{0, 3}, options);
+}
+
+TEST_F(ExhaustiveSearchTest, iterativeDeepening_withObjectiveLeftover_shouldReturnOneCorrectMove) {
+    SCOPED_TRACE("iterativeDeepening_withObjectiveLeftover_shouldReturnOneCorrectMove");
+    auto objective_id = graph_.getLeftover().node_id;
+    Location player_location{6, 2};
+    exh::SearchOptions options;
+    options.mode = exh::SearchMode::iterative_deepening;
+
+    performTest(graph_, player_location, objective_id, 1, Location{-1, -1}, options);
+}
+
+TEST_F(ExhaustiveSearchTest, iterativeDeepening_d2_self_push_out) {
+    SCOPED_TRACE("iterativeDeepening_d2_self_push_out");
+    buildGraph(mazes::difficult_maze, {OutPaths::North, OutPaths::East});
+    auto objective_id = graph_.getNode(Location{6, 6}).node_id;
+    Location player_location{0, 6};
+    exh::SearchOptions options;
+    options.mode = exh::SearchMode::iterative_deepening;
+
+    performTest(graph_, player_location, objective_id, 2, Location{-1, -1}, options);
+}
+
+TEST_F(ExhaustiveSearchTest, iterativeDeepening_withPreviousShift_shouldReturnTwoMoves) {
+    SCOPED_TRACE("iterativeDeepening_withPreviousShift_shouldReturnTwoMoves");
+    buildGraph(mazes::difficult_maze, {OutPaths::North, OutPaths::South});
+    auto objective_id = graph_.getLeftover().node_id;
+    Location player_location{6, 2};
+    exh::SearchOptions options;
+    options.mode = exh::SearchMode::iterative_deepening;
+
+    performTest(graph_, player_location, objective_id, 2, Location{0, 3}, options);
+}
+
+TEST_F(ExhaustiveSearchTest, iterativeDeepening_d3_shouldReturnSameActionsAsBreadthFirst) {
+    SCOPED_TRACE("iterativeDeepening_d3_shouldReturnSameActionsAsBreadthFirst");
+    buildGraph(mazes::difficult_maze, {OutPaths::North, OutPaths::East});
+    auto objective_id = graph_.getNode(Location{5, 1}).node_id;
+    Location player_location{0, 6};
+    solvers::SolverInstance solver_instance{graph_, player_location, Location{-1, -1}, objective_id, Location{-1, -1}};
+    exh::SearchOptions options;
+    options.mode = exh::SearchMode::iterative_deepening;
+
+    performTest(graph_, player_location, objective_id, 3, Location{-1, -1}, options);
+    auto expected_actions = exh::findBestActions(solver_instance);
+    auto actions = exh::findBestActionsWithOptions(solver_instance, options).actions;
+    expectSameActions(actions, expected_actions);
+}
+
+TEST_F(ExhaustiveSearchTest, iterativeDeepening_d4_generated) {
+    SCOPED_TRACE("iterativeDeepening_d4_generated");
+    buildGraph(mazes::exh_depth_4_maze, {OutPaths::North, OutPaths::East});
+    auto objective_id = graph_.getNode(Location{6, 7}).node_id;
+    Location player_location{4, 2};
+    exh::SearchOptions options;
+    options.mode = exh::SearchMode::iterative_deepening;
+
+    performTest(graph_, player_location, objective_id, 4, Location{-1, -1}, options);
+}
+
+TEST_F(ExhaustiveSearchTest, informed_withPreviousShiftAndObjectiveLeftover_shouldReturnTwoMoves) {
+    SCOPED_TRACE("informed_withPreviousShiftAndObjectiveLeftover_shouldReturnTwoMoves");
+    buildGraph(mazes::difficult_maze, {OutPaths::North, OutPaths::South});
+    auto objective_id = graph_.getLeftover().node_id;
+    Location player_location{6, 2};
+    exh::SearchOptions options;
+    options.mode = exh::SearchMode::informed;
+
+    performTest(graph_, player_location, objective_id, 2, Location{0, 3}, options);
+}
+
+TEST_F(ExhaustiveSearchTest, informed_d3_shouldReturnSameActionsAsBreadthFirst) {
+    SCOPED_TRACE("informed_d3_shouldReturnSameActionsAsBreadthFirst");
+    buildGraph(mazes::difficult_maze, {OutPaths::North, OutPaths::East});
+    auto objective_id = graph_.getNode(Location{5, 1}).node_id;
+    Location player_location{0, 6};
+    solvers::SolverInstance solver_instance{graph_, player_location, Location{-1, -1}, objective_id, Location{-1, -1}};
+    exh::SearchOptions options;
+    options.mode = exh::SearchMode::informed;
+
+    performTest(graph_, player_location, objective_id, 3, Location{-1, -1}, options);
+    auto expected_actions = exh::findBestActions(solver_instance);
+    auto actions = exh::findBestActionsWithOptions(solver_instance, options).actions;
+    expectSameActions(actions, expected_actions);
+}
+
+TEST_F(ExhaustiveSearchTest, informed_d4_shouldPruneStatesAndReturnSameActionsAsBreadthFirst) {
+    SCOPED_TRACE("informed_d4_shouldPruneStatesAndReturnSameActionsAsBreadthFirst");
+    buildGraph(mazes::exh_depth_4_maze, {OutPaths::North, OutPaths::East});
+    auto objective_id = graph_.getNode(Location{6, 7}).node_id;
+    Location player_location{4, 2};
+    solvers::SolverInstance solver_instance{graph_, player_location, Location{-1, -1}, objective_id, Location{-1, -1}};
+    exh::SearchOptions options;
+    options.mode = exh::SearchMode::informed;
+
+    const auto expected = exh::findBestActionsWithOptions(solver_instance, exh::SearchOptions{});
+    options.mode = exh::SearchMode::iterative_deepening;
+    const auto uninformed = exh::findBestActionsWithOptions(solver_instance, options);
+    options.mode = exh::SearchMode::informed;
+    const auto informed = exh::findBestActionsWithOptions(solver_instance, options);
+
+    ASSERT_EQ(informed.actions.size(), 4u);
+    expectSameActions(informed.actions, expected.actions);
+    EXPECT_GT(informed.statistics.pruned_states, 0u);
+    EXPECT_EQ(uninformed.statistics.pruned_states, 0u);
+    EXPECT_LT(informed.statistics.expanded_states, uninformed.statistics.expanded_states);
+}
+
+TEST_F(ExhaustiveSearchTest, informed_withObjectiveInsertedIntoParallelLine_shouldReturnSameActionsAsBreadthFirst) {
+    SCOPED_TRACE("informed_withObjectiveInsertedIntoParallelLine_shouldReturnSameActionsAsBreadthFirst");
+    buildClosedMaze();
+    auto objective_id = graph_.getNode(Location{1, 6}).node_id;
+    Location player_location{4, 0};
+    solvers::SolverInstance solver_instance{graph_, player_location, Location{-1, -1}, objective_id, Location{-1, -1}};
+    exh::SearchOptions options;
+    options.mode = exh::SearchMode::informed;
+
+    performTest(graph_, player_location, objective_id, 2, Location{-1, -1}, options);
+    auto expected_actions = exh::findBestActions(solver_instance);
+    auto actions = exh::findBestActionsWithOptions(solver_instance, options).actions;
+    expectSameActions(actions, expected_actions);
+}
+
+TEST_F(ExhaustiveSearchTest, maxMemory_whenExceeded_shouldFinishIterativeDeepeningWithSameActionsAsBreadthFirst) {
+    SCOPED_TRACE("maxMemory_whenExceeded_shouldFinishIterativeDeepeningWithSameActionsAsBreadthFirst");
+    buildGraph(mazes::exh_depth_4_maze, {OutPaths::North, OutPaths::East});
+    auto objective_id = graph_.getNode(Location{6, 7}).node_id;
+    Location player_location{4, 2};
+    solvers::SolverInstance solver_instance{graph_, player_location, Location{-1, -1}, objective_id, Location{-1, -1}};
+    exh::SearchOptions options;
+    options.max_memory_bytes = 1;
+
+    const auto expected = exh::findBestActionsWithOptions(solver_instance, exh::SearchOptions{});
+    const auto result = exh::findBestActionsWithOptions(solver_instance, options);
+
+    EXPECT_EQ(expected.finished_mode, exh::SearchMode::breadth_first);
+    EXPECT_EQ(result.finished_mode, exh::SearchMode::iterative_deepening);
+    ASSERT_EQ(result.actions.size(), 4u);
+    expectSameActions(result.actions, expected.actions);
+}
+
+TEST_F(ExhaustiveSearchTest, maxMemory_withObjectiveInsertedIntoParallelLine_shouldReturnSameActionsAsBreadthFirst) {
+    SCOPED_TRACE("maxMemory_withObjectiveInsertedIntoParallelLine_shouldReturnSameActionsAsBreadthFirst");
+    buildClosedMaze();
+    auto objective_id = graph_.getNode(Location{1, 6}).node_id;
+    Location player_location{4, 0};
+    solvers::SolverInstance solver_instance{graph_, player_location, Location{-1, -1}, objective_id, Location{-1, -1}};
+    exh::SearchOptions options;
+    options.max_memory_bytes = 1;
+
+    performTest(graph_, player_location, objective_id, 2, Location{-1, -1}, options);
+    const auto expected = exh::findBestActionsWithOptions(solver_instance, exh::SearchOptions{});
+    const auto result = exh::findBestActionsWithOptions(solver_instance, options);
+
+    EXPECT_EQ(result.finished_mode, exh::SearchMode::iterative_deepening);
+    expectSameActions(result.actions, expected.actions);
+}
+
+TEST_F(ExhaustiveSearchTest, maxMemory_whenNotExceeded_shouldFinishBreadthFirst) {
+    SCOPED_TRACE("maxMemory_whenNotExceeded_shouldFinishBreadthFirst");
+    auto objective_id = graph_.getNode(Location{6, 6}).node_id;
+    Location player_location{3, 3};
+    solvers::SolverInstance solver_instance{graph_, player_location, Location{-1, -1}, objective_id, Location{-1, -1}};
+    exh::SearchOptions options;
+    options.max_memory_bytes = 1u << 30;
+
+    performTest(graph_, player_location, objective_id, 2, Location{-1, -1}, options);
+    EXPECT_EQ(exh::findBestActionsWithOptions(solver_instance, options).finished_mode, exh::SearchMode::breadth_first);
+}
+
+TEST_F(ExhaustiveSearchTest, multipleThreads_d3_shouldReturnSameActionsAsSingleThread) {
+    SCOPED_TRACE("multipleThreads_d3_shouldReturnSameActionsAsSingleThread");
+    buildGraph(mazes::difficult_maze, {OutPaths::North, OutPaths::South});
+    auto objective_id = graph_.getNode(Location{1, 1}).node_id;
+    Location player_location{4, 6};
+    solvers::SolverInstance solver_instance{graph_, player_location, Location{-1, -1}, objective_id, Location{-1, -1}};
+    exh::SearchOptions options;
+    options.num_threads = 4;
+
+    performTest(graph_, player_location, objective_id, 3, Location{-1, -1}, options);
+    auto expected_actions = exh::findBestActions(solver_instance);
+    auto actions = exh::findBestActionsWithOptions(solver_instance, options).actions;
+    expectSameActions(actions, expected_actions);
+}
+
+TEST_F(ExhaustiveSearchTest, multipleThreads_withDuplicateElimination_d4_shouldReturnSameActionsAsSingleThread) {
+    SCOPED_TRACE("multipleThreads_withDuplicateElimination_d4_shouldReturnSameActionsAsSingleThread");
+    buildGraph(mazes::exh_depth_4_maze, {OutPaths::North, OutPaths::East});
+    auto objective_id = graph_.getNode(Location{6, 7}).node_id;
+    Location player_location{4, 2};
+    solvers::SolverInstance solver_instance{graph_, player_location, Location{-1, -1}, objective_id, Location{-1, -1}};
+    exh::SearchOptions options;
+    options.num_threads = 3;
+    options.eliminate_duplicates = true;
+
+    performTest(graph_, player_location, objective_id, 4, Location{-1, -1}, options);
+    auto expected_actions = exh::findBestActions(solver_instance);
+    auto actions = exh::findBestActionsWithOptions(solver_instance, options).actions;
+    expectSameActions(actions, expected_actions);
+}
+
+TEST_F(ExhaustiveSearchTest, oneThreadPerCore_d2_two_shifts) {
+    SCOPED_TRACE("oneThreadPerCore_d2_two_shifts");
+    auto objective_id = graph_.getNode(Location{6, 6}).node_id;
+    Location player_location{3, 3};
+    exh::SearchOptions options;
+    options.num_threads = 0;
+
+    performTest(graph_, player_location, objective_id, 2, Location{-1, -1}, options);
+}
+
 TEST_F(ExhaustiveSearchTest, d4_generated_86s) {
     SCOPED_TRACE("d4_generated_depth4");
     buildGraph(mazes::exh_depth_4_maze, {OutPaths::North, OutPaths::East});
@@ -245,6 +500,47 @@ TEST_F(ExhaustiveSearchTest, depth4Instance_whenAborted_shouldReturnQuicklyWitho
     ASSERT_THAT(actions, testing::IsEmpty());
 }
 
+TEST_F(ExhaustiveSearchTest, depth4Instance_withPartialPlan_whenAborted_shouldReturnCorrectActions) {
+    SCOPED_TRACE("depth4Instance_withPartialPlan_whenAborted_shouldReturnCorrectActions");
+    using namespace std::chrono_literals;
+    buildGraph(mazes::exh_depth_4_maze, {OutPaths::North, OutPaths::East});
+    auto objective_id = graph_.getNode(Location{6, 7}).node_id;
+    Location player_location{4, 2};
+    Location previous_shift{-1, -1};
+    solvers::SolverInstance solver_instance{graph_, player_location, Location{-1, -1}, objective_id, previous_shift};
+    for (auto mode : {exh::SearchMode::breadth_first, exh::SearchMode::informed}) {
+        exh::SearchOptions options;
+        options.mode = mode;
+        options.return_partial_plan = true;
+
+        auto future_result = std::async(std::launch::async, exh::findBestActionsWithOptions, solver_instance, options);
+        std::this_thread::sleep_for(10ms);
+        exh::abortComputation();
+        auto result = future_result.get();
+
+        ASSERT_THAT(result.actions, testing::SizeIs(testing::Ge(1)));
+        EXPECT_TRUE(result.is_partial);
+        EXPECT_TRUE(isCorrectPlayerActionSequence(result.actions, graph_, player_location));
+        EXPECT_TRUE(respectPushbackRule(result.actions, graph_.getExtent(), previous_shift));
+    }
+}
+
+TEST_F(ExhaustiveSearchTest, withPartialPlan_whenNotAborted_shouldReturnSameActions) {
+    SCOPED_TRACE("withPartialPlan_whenNotAborted_shouldReturnSameActions");
+    buildGraph(mazes::difficult_maze, {OutPaths::North, OutPaths::East});
+    auto objective_id = graph_.getNode(Location{5, 1}).node_id;
+    Location player_location{0, 6};
+    solvers::SolverInstance solver_instance{graph_, player_location, Location{-1, -1}, objective_id, Location{-1, -1}};
+    exh::SearchOptions options;
+    options.return_partial_plan = true;
+
+    auto expected_actions = exh::findBestActions(solver_instance);
+    auto result = exh::findBestActionsWithOptions(solver_instance, options);
+
+    EXPECT_FALSE(result.is_partial);
+    expectSameActions(result.actions, expected_actions);
+}
+
 TEST_F(ExhaustiveSearchTest, depth4Instance_whenAborted_runsFineAfterwards) {
     SCOPED_TRACE("depth4Instance_whenAborted_runsFineAfterwards");
     buildGraph(mazes::exh_depth_4_maze, {OutPaths::North, OutPaths::East});
@@ -84,3 +84,215 @@ TEST_F(GraphAlgorithmsTest, multiSourceReachableLocations_withTwoSources_returns
     ASSERT_TRUE(reachableFromIndex(reachableLocations, Location{2, 1}, 1));
     ASSERT_TRUE(reachableFromIndex(reachableLocations, Location{2, 2}, 1));
 }
+
+TEST(GraphAlgorithmsExtentTest, reachableLocations_withExtent13AndOnlyCrosses_reachesAllLocations) {
+    MazeGraph graph{13};
+    for (auto row = 0; row < 13; ++row) {
+        for (auto column = 0; column < 13; ++column) {
+            graph.setOutPaths(Location{row, column}, OutPaths{15});
+        }
+    }
+
+    auto reachable_locations = reachable::reachableLocations(graph, Location{6, 6});
+
+    EXPECT_THAT(reachable_locations, testing::SizeIs(169));
+    EXPECT_EQ(reachable_locations[0], (Location{6, 6}));
+    EXPECT_TRUE(reachable::isReachable(graph, Location{0, 0}, Location{12, 12}));
+}
+
+TEST(GraphAlgorithmsExtentTest, multiSourceReachableLocations_withExtent33AndTwoHalves_attributesEachHalf) {
+    // too large for a RowMaskBoard, so that the breadth-first search is used
+    MazeGraph graph{33};
+    for (auto row = 0; row < 33; ++row) {
+        for (auto column = 0; column < 33; ++column) {
+            graph.setOutPaths(Location{row, column}, row == 16 ? OutPaths{10} : OutPaths{15});
+        }
+    }
+
+    auto reachable_nodes = reachable::multiSourceReachableLocations(graph, {Location{0, 0}, Location{32, 32}});
+
+    const auto num_first = std::count_if(reachable_nodes.begin(), reachable_nodes.end(), [](const auto& node) {
+        return node.parent_source_index == 0;
+    });
+    // the middle row only connects to itself
+    EXPECT_THAT(reachable_nodes, testing::SizeIs(33 * 32));
+    EXPECT_EQ(num_first, 33 * 16);
+}
+
+TEST_F(GraphAlgorithmsTest, reachableLocations_returnsSourceFirst) {
+    auto reachable_locations = reachable::reachableLocations(graph_, Location{1, 1});
+
+    EXPECT_THAT(reachable_locations, testing::SizeIs(7));
+    EXPECT_EQ(reachable_locations[0], (Location{1, 1}));
+}
+
+TEST_F(GraphAlgorithmsTest, multiSourceReachableLocations_withSourcesInSameComponent_attributesToFirstSource) {
+    std::vector<Location> sources = {Location{2, 1}, Location{0, 0}, Location{2, 2}};
+    auto reachableLocations = reachable::multiSourceReachableLocations(graph_, sources);
+    ASSERT_THAT(reachableLocations, testing::SizeIs(9));
+    ASSERT_TRUE(reachableFromIndex(reachableLocations, Location{2, 2}, 0));
+    ASSERT_TRUE(reachableFromIndex(reachableLocations, Location{1, 1}, 1));
+}
+
+TEST_F(GraphAlgorithmsTest, reachableCells_withReusedWorkspace_doesNotReallocate) {
+    MazeGraph large_graph{13};
+    for (auto row = 0; row < 13; ++row) {
+        for (auto column = 0; column < 13; ++column) {
+            large_graph.setOutPaths(Location{row, column}, OutPaths{15});
+        }
+    }
+    reachable::BfsWorkspace workspace;
+    const auto& large_cells = reachable::reachableCells(large_graph, 0, workspace);
+    EXPECT_THAT(large_cells, testing::SizeIs(169));
+    const CellIndex* buffer = large_cells.data();
+
+    const auto& cells = reachable::reachableCells(graph_, graph_.getLayout().toCellIndex(Location{1, 1}), workspace);
+    EXPECT_THAT(cells, testing::SizeIs(7));
+    EXPECT_EQ(cells.data(), buffer);
+    EXPECT_TRUE(reachable::isReachable(large_graph, Location{0, 0}, Location{12, 12}, workspace));
+    EXPECT_FALSE(reachable::isReachable(graph_, Location{0, 0}, Location{2, 2}, workspace));
+    EXPECT_THAT(reachable::reachableCells(large_graph, 5, workspace), testing::SizeIs(169));
+    EXPECT_EQ(workspace.cellsBuffer().data(), buffer);
+}
+
+TEST(GraphAlgorithmsExtentTest, isReachable_withAllStrategies_agreesWithReachableLocations) {
+    for (const int extent : {7, 13}) {
+        MazeGraph graph{extent};
+        for (auto row = 0; row < extent; ++row) {
+            for (auto column = 0; column < extent; ++column) {
+                const auto out_paths = static_cast<OutPathsIntegerType>((row * 7 + column * 13 + 5) % 15 + 1);
+                graph.setOutPaths(Location{row, column}, static_cast<OutPaths>(out_paths));
+            }
+        }
+        const Location source{extent / 2, 1};
+        const auto reached = reachable::reachableLocations(graph, source);
+        std::vector<Location> targets;
+        for (auto row = 0; row < extent; ++row) {
+            for (auto column = 0; column < extent; ++column) {
+                targets.emplace_back(row, column);
+            }
+        }
+        const auto batch_result = reachable::areReachable(graph, source, targets);
+        reachable::BfsWorkspace workspace;
+        for (size_t i = 0; i < targets.size(); ++i) {
+            const Location& target = targets[i];
+            const bool expected = std::find(reached.begin(), reached.end(), target) != reached.end();
+            EXPECT_EQ(batch_result[i], expected) << "for " << target;
+            for (auto strategy : {reachable::ReachabilityStrategy::forward,
+                                  reachable::ReachabilityStrategy::bidirectional,
+                                  reachable::ReachabilityStrategy::goal_directed}) {
+                EXPECT_EQ(reachable::isReachable(graph, source, target, workspace, strategy), expected)
+                    << "for " << target << " with extent " << extent;
+            }
+        }
+    }
+}
+
+TEST(GraphAlgorithmsExtentTest, allChildrenReachability_agreesWithMultiSourceReachableCells) {
+    for (const int extent : {7, 13}) {
+        MazeGraph graph{extent};
+        for (auto row = 0; row < extent; ++row) {
+            for (auto column = 0; column < extent; ++column) {
+                const auto out_paths = static_cast<OutPathsIntegerType>((row * 5 + column * 11 + 3) % 15 + 1);
+                graph.setOutPaths(Location{row, column}, static_cast<OutPaths>(out_paths));
+            }
+        }
+        graph.setLeftoverOutPaths(static_cast<OutPaths>(3));
+        for (auto pos = 1; pos < extent; pos += 2) {
+            graph.addShiftLocation(Location{0, pos});
+            graph.addShiftLocation(Location{extent - 1, pos});
+            graph.addShiftLocation(Location{pos, 0});
+            graph.addShiftLocation(Location{pos, extent - 1});
+        }
+        const auto hash = graph.getHash();
+        const CellLayout& layout = graph.getLayout();
+        const std::vector<CellIndex> sources{layout.toCellIndex(Location{1, 2}),
+                                             layout.toCellIndex(Location{extent - 1, 1}),
+                                             layout.toCellIndex(Location{extent / 2, extent / 2})};
+        const Location previous_shift{0, 1};
+        const auto children = reachable::allChildrenReachability(graph, sources, previous_shift);
+
+        EXPECT_EQ(graph.getHash(), hash);
+        size_t child_index = 0;
+        for (const auto& shift_location : graph.getShiftLocations()) {
+            if (shift_location == opposingShiftLocation(previous_shift, extent)) {
+                continue;
+            }
+            for (auto rotation : {RotationDegreeType::_0, RotationDegreeType::_90, RotationDegreeType::_180,
+                                  RotationDegreeType::_270}) {
+                ASSERT_LT(child_index, children.getNumberOfChildren());
+                const auto& child = children.getChild(child_index);
+                EXPECT_EQ(child.shift_location, shift_location);
+                EXPECT_EQ(child.rotation, rotation);
+                MazeGraph shifted_graph{graph};
+                shifted_graph.shift(shift_location, rotation);
+                std::vector<CellIndex> shifted_sources;
+                for (CellIndex source : sources) {
+                    shifted_sources.push_back(layout.translateByShift(source, layout.toCellIndex(shift_location)));
+                }
+                const auto expected = reachable::multiSourceReachableCells(shifted_graph, shifted_sources);
+                const std::vector<reachable::ReachableCell> actual(children.reachedCellsBegin(child_index),
+                                                                   children.reachedCellsEnd(child_index));
+                ASSERT_EQ(actual.size(), expected.size()) << "for " << shift_location << " with extent " << extent;
+                for (const auto& reachable_cell : expected) {
+                    EXPECT_TRUE(children.isReached(child_index, reachable_cell.reached_cell));
+                    EXPECT_TRUE(std::any_of(actual.begin(), actual.end(), [&reachable_cell](const auto& cell) {
+                        return cell.reached_cell == reachable_cell.reached_cell &&
+                               cell.parent_source_index == reachable_cell.parent_source_index;
+                    })) << "for " << shift_location << " with extent " << extent;
+                }
+                ++child_index;
+            }
+        }
+        EXPECT_EQ(child_index, children.getNumberOfChildren());
+        EXPECT_EQ(child_index, 4 * (graph.getShiftLocations().size() - 1));
+    }
+}
+
+TEST_F(GraphAlgorithmsTest, distanceMap_withTwoSources_returnsPathLengthsAndNearestSources) {
+    const CellLayout& layout = graph_.getLayout();
+    const std::vector<CellIndex> sources{layout.toCellIndex(Location{0, 0}), layout.toCellIndex(Location{2, 2})};
+    std::vector<reachable::CellDistance> distances;
+    reachable::distanceMap(graph_, sources, distances);
+
+    ASSERT_EQ(distances.size(), layout.getNumberOfCells());
+    EXPECT_EQ(distances[sources[0]].distance, 0);
+    EXPECT_EQ(distances[sources[0]].nearest_source_index, 0);
+    EXPECT_EQ(distances[sources[1]].distance, 0);
+    EXPECT_EQ(distances[sources[1]].nearest_source_index, 1);
+    for (CellIndex cell = 0; cell < layout.getNumberOfCells(); ++cell) {
+        const Location location = layout.toLocation(cell);
+        const bool is_reachable = reachable::isReachable(graph_, layout.toLocation(sources[0]), location) ||
+                                  reachable::isReachable(graph_, layout.toLocation(sources[1]), location);
+        EXPECT_EQ(distances[cell].isReachable(), is_reachable) << "for " << layout.toLocation(cell);
+    }
+}
+
+TEST(GraphAlgorithmsExtentTest, distanceMap_withStraightCorridor_returnsPathLengths) {
+    MazeGraph graph{9};
+    for (auto column = 0; column < 9; ++column) {
+        graph.setOutPaths(Location{4, column}, static_cast<OutPaths>(10));
+    }
+    const CellLayout& layout = graph.getLayout();
+    std::vector<reachable::CellDistance> distances;
+    reachable::distanceMap(graph, {layout.toCellIndex(Location{4, 0})}, distances);
+
+    for (auto column = 0; column < 9; ++column) {
+        EXPECT_EQ(distances[layout.toCellIndex(Location{4, column})].distance, column);
+    }
+    EXPECT_FALSE(distances[layout.toCellIndex(Location{3, 0})].isReachable());
+}
+
+TEST(GraphAlgorithmsExtentTest, closestReachableCell_returnsTargetOrClosestCell) {
+    MazeGraph graph{9};
+    for (auto column = 0; column < 9; ++column) {
+        graph.setOutPaths(Location{4, column}, static_cast<OutPaths>(10));
+    }
+    const CellLayout& layout = graph.getLayout();
+    const CellIndex source = layout.toCellIndex(Location{4, 0});
+
+    EXPECT_EQ(reachable::closestReachableCell(graph, source, layout.toCellIndex(Location{4, 6})),
+              layout.toCellIndex(Location{4, 6}));
+    EXPECT_EQ(reachable::closestReachableCell(graph, source, layout.toCellIndex(Location{0, 5})),
+              layout.toCellIndex(Location{4, 5}));
+}
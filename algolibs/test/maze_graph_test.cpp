@@ -5,6 +5,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <numeric>
 #include <set>
 
 using namespace labyrinth;
@@ -232,7 +233,7 @@ TEST_F(MazeGraphTest, shift_cornerWithRotation_resultsInCorrectNeighbors) {
 }
 
 TEST_F(MazeGraphTest, givenPushedOutNodeWasRotated_whenShift_newLeftoverKeepsRotation) {
-    graph_.getNode(Location{2, 1}).rotation = RotationDegreeType::_180;
+    graph_.setRotation(Location{2, 1}, RotationDegreeType::_180);
 
     graph_.shift(Location{0, 1}, RotationDegreeType::_0);
 
@@ -386,3 +387,301 @@ TEST_F(MazeGraphTest, getLocation_withLinearizedInputNodes_returnsCorrectLocatio
     EXPECT_EQ(input_graph.getLocation(2, Location{-1, -1}), (Location{2, 1}));
     EXPECT_EQ(input_graph.getLocation(3, Location{-1, -1}), (Location{2, 2}));
 }
+
+namespace {
+
+/// Shifts node ids of a row-wise id matrix node by node, as a reference for MazeGraph::shift
+void shiftReferenceIds(std::vector<NodeId>& ids, NodeId& leftover_id, const Location& location, int extent) {
+    const auto offset = getOffsetByShiftLocation(location, extent);
+    auto index = [extent](const Location& l) { return l.getRow() * extent + l.getColumn(); };
+    auto to_location = opposingShiftLocation(location, extent);
+    const NodeId pushed_out_id = ids[index(to_location)];
+    for (auto i = 0; i < extent - 1; ++i) {
+        auto from_location = to_location - offset;
+        ids[index(to_location)] = ids[index(from_location)];
+        to_location = from_location;
+    }
+    ids[index(to_location)] = leftover_id;
+    leftover_id = pushed_out_id;
+}
+
+} // namespace
+
+TEST(MazeGraphShiftTest, shift_withAlternatingRowsAndColumns_resultsInSameNodeIdsAsReference) {
+    const int extent = 7;
+    MazeGraph graph{extent};
+    for (auto pos = 1; pos < extent; pos += 2) {
+        graph.addShiftLocation(Location{0, pos});
+        graph.addShiftLocation(Location{pos, extent - 1});
+        graph.addShiftLocation(Location{extent - 1, pos});
+        graph.addShiftLocation(Location{pos, 0});
+    }
+    std::vector<NodeId> ids(extent * extent);
+    std::iota(ids.begin(), ids.end(), 0);
+    NodeId leftover_id = extent * extent;
+    const auto& shift_locations = graph.getShiftLocations();
+
+    size_t choice = 0;
+    for (auto step = 0; step < 200; ++step) {
+        choice = (choice * 7 + 5) % shift_locations.size();
+        const auto& shift_location = shift_locations[choice];
+        graph.shift(shift_location, RotationDegreeType::_0);
+        shiftReferenceIds(ids, leftover_id, shift_location, extent);
+
+        ASSERT_EQ(graph.getLeftover().node_id, leftover_id) << "after step " << step;
+        for (auto row = 0; row < extent; ++row) {
+            for (auto column = 0; column < extent; ++column) {
+                ASSERT_EQ(graph.getNode(Location{row, column}).node_id, ids[row * extent + column])
+                    << "at " << Location{row, column} << " after step " << step;
+                ASSERT_EQ(graph.getLocation(ids[row * extent + column], Location{-1, -1}), (Location{row, column}))
+                    << "after step " << step;
+            }
+        }
+    }
+}
+
+TEST(MazeGraphShiftTest, getConnectedEdges_afterShifts_agreesWithOutPathsOfNeighbors) {
+    const int extent = 7;
+    std::vector<Node> nodes;
+    for (NodeId node_id = 0; node_id <= extent * extent; ++node_id) {
+        const auto out_paths = static_cast<OutPathsIntegerType>((node_id * 7 + 3) % 15 + 1);
+        nodes.push_back(Node{node_id, static_cast<OutPaths>(out_paths), RotationDegreeType::_0});
+    }
+    MazeGraph graph{nodes};
+    for (auto pos = 1; pos < extent; pos += 2) {
+        graph.addShiftLocation(Location{0, pos});
+        graph.addShiftLocation(Location{pos, extent - 1});
+        graph.addShiftLocation(Location{extent - 1, pos});
+        graph.addShiftLocation(Location{pos, 0});
+    }
+    const auto& shift_locations = graph.getShiftLocations();
+    using OffsetType = Location::OffsetType;
+    const std::vector<std::pair<OutPaths, OffsetType>> directions{{OutPaths::North, OffsetType{-1, 0}},
+                                                                  {OutPaths::East, OffsetType{0, 1}},
+                                                                  {OutPaths::South, OffsetType{1, 0}},
+                                                                  {OutPaths::West, OffsetType{0, -1}}};
+    const auto opposite = [](OutPaths out_path) {
+        const auto value = static_cast<OutPathsIntegerType>(out_path);
+        return static_cast<OutPaths>(value < 4 ? value << 2 : value >> 2);
+    };
+
+    size_t choice = 0;
+    for (auto step = 0; step < 50; ++step) {
+        choice = (choice * 7 + 5) % shift_locations.size();
+        graph.shift(shift_locations[choice], static_cast<RotationDegreeType>(step % 4));
+        for (auto row = 0; row < extent; ++row) {
+            for (auto column = 0; column < extent; ++column) {
+                const Location location{row, column};
+                OutPathsIntegerType expected = 0;
+                for (const auto& direction : directions) {
+                    const auto neighbor = location + direction.second;
+                    if (neighbor.getRow() >= 0 && neighbor.getRow() < extent && neighbor.getColumn() >= 0 &&
+                        neighbor.getColumn() < extent && graph.hasOutPath(location, direction.first) &&
+                        graph.hasOutPath(neighbor, opposite(direction.first))) {
+                        expected |= static_cast<OutPathsIntegerType>(direction.first);
+                    }
+                }
+                ASSERT_EQ(graph.getConnectedEdges(location), expected) << "at " << location << " after step " << step;
+            }
+        }
+    }
+}
+
+TEST_F(MazeGraphTest, shift_followedByOpposingShift_restoresNodeIdsAndPaths) {
+    std::vector<Node> nodes_before;
+    for (auto row = 0u; row < MazeGraphTest::extent; row++) {
+        for (auto column = 0u; column < MazeGraphTest::extent; column++) {
+            nodes_before.push_back(graph_.getNode(Location{row, column}));
+        }
+    }
+    const auto leftover_id = graph_.getLeftover().node_id;
+
+    graph_.shift(Location{1, 0}, RotationDegreeType::_0);
+    graph_.shift(Location{1, 2}, RotationDegreeType::_0);
+
+    EXPECT_EQ(graph_.getLeftover().node_id, leftover_id);
+    auto expected = nodes_before.begin();
+    for (auto row = 0u; row < MazeGraphTest::extent; row++) {
+        for (auto column = 0u; column < MazeGraphTest::extent; column++, ++expected) {
+            EXPECT_EQ(graph_.getNode(Location{row, column}).node_id, expected->node_id);
+            EXPECT_EQ(graph_.getNode(Location{row, column}).out_paths, expected->out_paths);
+        }
+    }
+    EXPECT_TRUE(hasNeighbors(graph_, Location{1, 0}, {Location{0, 0}, Location{1, 1}, Location{2, 0}}));
+}
+
+TEST_F(MazeGraphTest, setOutPathsAndSetRotation_keepEachOtherAndNodeId) {
+    const NodeId node_id = graph_.getNodeId(Location{1, 1});
+
+    graph_.setRotation(Location{1, 1}, RotationDegreeType::_270);
+    graph_.setOutPaths(Location{1, 1}, getBitmask("NES"));
+
+    const Node node = graph_.getNode(Location{1, 1});
+    EXPECT_EQ(node.node_id, node_id);
+    EXPECT_EQ(node.out_paths, getBitmask("NES"));
+    EXPECT_EQ(node.rotation, RotationDegreeType::_270);
+    EXPECT_TRUE(graph_.hasOutPath(Location{1, 1}, OutPaths::West));
+    EXPECT_FALSE(graph_.hasOutPath(Location{1, 1}, OutPaths::South));
+}
+
+TEST_F(MazeGraphTest, undo_afterApplyShiftAndRotation_restoresNodesAndLeftover) {
+    graph_.setRotation(Location{2, 1}, RotationDegreeType::_90);
+    std::vector<Node> nodes_before;
+    std::vector<OutPathsIntegerType> edges_before;
+    for (auto row = 0u; row < MazeGraphTest::extent; row++) {
+        for (auto column = 0u; column < MazeGraphTest::extent; column++) {
+            nodes_before.push_back(graph_.getNode(Location{row, column}));
+            edges_before.push_back(graph_.getConnectedEdges(Location{row, column}));
+        }
+    }
+    const Node leftover_before = graph_.getLeftover();
+
+    const auto first_record = graph_.applyShift(Location{0, 1}, RotationDegreeType::_180);
+    const auto second_record = graph_.applyShift(Location{1, 2}, RotationDegreeType::_270);
+    graph_.setRotation(Location{1, 2}, RotationDegreeType::_90);
+    graph_.undo(second_record);
+    graph_.undo(first_record);
+
+    EXPECT_EQ(graph_.getLeftover().node_id, leftover_before.node_id);
+    EXPECT_EQ(graph_.getLeftover().rotation, leftover_before.rotation);
+    auto expected = nodes_before.begin();
+    auto expected_edges = edges_before.begin();
+    for (auto row = 0u; row < MazeGraphTest::extent; row++) {
+        for (auto column = 0u; column < MazeGraphTest::extent; column++, ++expected, ++expected_edges) {
+            const Location location{row, column};
+            EXPECT_EQ(graph_.getNode(location).node_id, expected->node_id) << "at " << location;
+            EXPECT_EQ(graph_.getNode(location).rotation, expected->rotation) << "at " << location;
+            EXPECT_EQ(graph_.getConnectedEdges(location), *expected_edges) << "at " << location;
+        }
+    }
+}
+
+TEST(MazeGraphHashTest, getHash_afterShifts_equalsHashOfEquivalentNewGraph) {
+    const int extent = 7;
+    MazeGraph graph{extent};
+    for (auto pos = 1; pos < extent; pos += 2) {
+        graph.addShiftLocation(Location{0, pos});
+        graph.addShiftLocation(Location{pos, extent - 1});
+        graph.addShiftLocation(Location{extent - 1, pos});
+        graph.addShiftLocation(Location{pos, 0});
+    }
+    const auto& shift_locations = graph.getShiftLocations();
+    size_t choice = 0;
+    for (auto step = 0; step < 30; ++step) {
+        choice = (choice * 7 + 5) % shift_locations.size();
+        graph.shift(shift_locations[choice], static_cast<RotationDegreeType>(step % 4));
+        graph.setRotation(Location{step % extent, 3}, static_cast<RotationDegreeType>((step + 1) % 4));
+
+        std::vector<Node> nodes;
+        for (auto row = 0; row < extent; ++row) {
+            for (auto column = 0; column < extent; ++column) {
+                nodes.push_back(graph.getNode(Location{row, column}));
+            }
+        }
+        nodes.push_back(graph.getLeftover());
+        ASSERT_EQ(graph.getHash(), MazeGraph{nodes}.getHash()) << "after step " << step;
+        ASSERT_EQ(graph.getVerificationHash(), MazeGraph{nodes}.getVerificationHash()) << "after step " << step;
+    }
+}
+
+TEST_F(MazeGraphTest, getHash_afterApplyShiftAndUndo_isRestored) {
+    const auto hash_before = graph_.getHash();
+
+    const auto record = graph_.applyShift(Location{1, 0}, RotationDegreeType::_90);
+    const auto shifted_hash = graph_.getHash();
+    graph_.setRotation(Location{1, 0}, RotationDegreeType::_180);
+    EXPECT_NE(graph_.getHash(), shifted_hash);
+    graph_.undo(record);
+
+    EXPECT_NE(shifted_hash, hash_before);
+    EXPECT_EQ(graph_.getHash(), hash_before);
+}
+
+TEST_F(MazeGraphTest, hashesAfterShift_equalHashAfterApplyShift) {
+    for (const Location& shift_location : {Location{0, 1}, Location{1, 2}, Location{2, 1}, Location{1, 0}}) {
+        for (auto rotation : {RotationDegreeType::_0, RotationDegreeType::_90, RotationDegreeType::_270}) {
+            const auto expected_hash =
+                graph_.hashesAfterShift(shift_location)[static_cast<RotationDegreeIntegerType>(rotation)];
+            const auto record = graph_.applyShift(shift_location, rotation);
+            EXPECT_EQ(graph_.getHash(), expected_hash) << "for " << shift_location;
+            // also varies the maze for the following iterations
+            graph_.setRotation(Location{1, 1}, rotation);
+            graph_.undo(record);
+        }
+    }
+}
+
+TEST_F(MazeGraphTest, verificationHashesAfterShift_equalVerificationHashAfterApplyShift) {
+    for (const Location& shift_location : {Location{0, 1}, Location{1, 2}, Location{2, 1}, Location{1, 0}}) {
+        for (auto rotation : {RotationDegreeType::_0, RotationDegreeType::_180, RotationDegreeType::_270}) {
+            const auto rotation_index = static_cast<RotationDegreeIntegerType>(rotation);
+            const auto expected_hash = graph_.verificationHashesAfterShift(shift_location)[rotation_index];
+            const auto record = graph_.applyShift(shift_location, rotation);
+            EXPECT_EQ(graph_.getVerificationHash(), expected_hash) << "for " << shift_location;
+            EXPECT_NE(graph_.getVerificationHash(), graph_.getHash()) << "for " << shift_location;
+            graph_.setRotation(Location{1, 1}, rotation);
+            graph_.undo(record);
+        }
+    }
+}
+
+TEST(MazeGraphLocationTest, getLocation_withNodeIdsBeyondNumberOfNodes_findsLocationsAfterShift) {
+    std::vector<Node> nodes;
+    for (NodeId node_id = 100; node_id < 110; ++node_id) {
+        nodes.push_back(Node{node_id, getBitmask("NESW"), RotationDegreeType::_0});
+    }
+    MazeGraph graph{nodes};
+
+    graph.shift(Location{0, 1}, RotationDegreeType::_0);
+
+    EXPECT_EQ(graph.getLocation(109, Location{-1, -1}), (Location{0, 1}));
+    EXPECT_EQ(graph.getLocation(101, Location{-1, -1}), (Location{1, 1}));
+    EXPECT_EQ(graph.getLocation(107, Location{-1, -1}), (Location{-1, -1}));
+}
+
+TEST_F(MazeGraphTest, getLocation_withPushedOutNode_returnsGivenLocation) {
+    auto pushed_out_id = graph_.getNode(Location{2, 1}).node_id;
+
+    graph_.shift(Location{0, 1}, RotationDegreeType::_0);
+
+    EXPECT_EQ(graph_.getLocation(pushed_out_id, Location{-1, -1}), (Location{-1, -1}));
+}
+
+TEST_F(MazeGraphTest, getRotatedOutPaths_afterShiftsAndRotations_agreesWithNodes) {
+    graph_.shift(Location{0, 1}, RotationDegreeType::_90);
+    graph_.shift(Location{1, 2}, RotationDegreeType::_270);
+    graph_.setRotation(Location{1, 1}, RotationDegreeType::_180);
+    graph_.setOutPaths(Location{2, 2}, getBitmask("NE"));
+
+    for (auto row = 0u; row < MazeGraphTest::extent; row++) {
+        for (auto column = 0u; column < MazeGraphTest::extent; column++) {
+            const Location location{row, column};
+            for (auto out_path : {OutPaths::North, OutPaths::East, OutPaths::South, OutPaths::West}) {
+                EXPECT_EQ(graph_.hasOutPath(location, out_path), hasOutPath(graph_.getNode(location), out_path))
+                    << "at " << location;
+            }
+        }
+    }
+}
+
+TEST(ShiftLocationTest, shiftLocationFunctions_canBeEvaluatedAtCompileTime) {
+    static_assert(opposingShiftLocation(Location{0, 3}, 7) == Location{6, 3});
+    static_assert(opposingShiftLocation(Location{5, 6}, 7) == Location{5, 0});
+    static_assert(translateLocationByShift(Location{6, 3}, Location{0, 3}, 7) == Location{0, 3});
+    static_assert(translateLocationByShift(Location{2, 2}, Location{0, 3}, 7) == Location{2, 2});
+    static_assert(getOffsetByShiftLocation(Location{3, 8}, 9).column_offset == -1);
+    static_assert(revertTranslationByShift(Location{0, 3}, Location{0, 3}, 7) == Location{6, 3});
+    static_assert(revertTranslationByShift(Location{4, 3}, Location{0, 3}, 7) == Location{3, 3});
+    SUCCEED();
+}
+
+TEST(DispatchExtentTest, dispatchExtent_withCommonExtent_passesCompileTimeConstant) {
+    auto is_static = [](auto extent) { return !std::is_same_v<decltype(extent), MazeGraph::ExtentType>; };
+    auto value = [](auto extent) { return static_cast<MazeGraph::ExtentType>(extent); };
+
+    EXPECT_TRUE(dispatchExtent(7, is_static));
+    EXPECT_TRUE(dispatchExtent(11, is_static));
+    EXPECT_FALSE(dispatchExtent(13, is_static));
+    EXPECT_EQ(dispatchExtent(9, value), 9);
+    EXPECT_EQ(dispatchExtent(5, value), 5);
+}
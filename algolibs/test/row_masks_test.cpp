@@ -0,0 +1,109 @@
+#include "solvers/maze_graph.h"
+#include "solvers/row_masks.h"
+
+#include "gtest/gtest.h"
+
+#include <queue>
+#include <string>
+#include <vector>
+
+using namespace labyrinth;
+
+namespace {
+
+MazeGraph createRandomGraph(int extent, unsigned int seed) {
+    MazeGraph graph{extent};
+    for (auto row = 0; row < extent; ++row) {
+        for (auto column = 0; column < extent; ++column) {
+            seed = seed * 1103515245u + 12345u;
+            // Prefers corridors and corners, so that there are both long paths and several components.
+            const OutPathsIntegerType out_paths[] = {5, 10, 3, 6, 12, 9, 7, 15};
+            graph.setOutPaths(Location{row, column}, static_cast<OutPaths>(out_paths[(seed >> 16) % 8]));
+        }
+    }
+    return graph;
+}
+
+/// Reference implementation, which follows the neighbors of each location with a plain breadth-first search.
+/// Returns whether each location is reached, row-wise.
+std::vector<bool> reachableByBreadthFirstSearch(const MazeGraph& graph, const Location& source) {
+    const int extent = graph.getExtent();
+    std::vector<bool> is_reached(extent * extent, false);
+    std::queue<Location> queue;
+    queue.push(source);
+    is_reached[source.getRow() * extent + source.getColumn()] = true;
+    while (!queue.empty()) {
+        const Location location = queue.front();
+        queue.pop();
+        for (auto neighbor_it = graph.neighbors(location); !neighbor_it.isAtEnd(); ++neighbor_it) {
+            const Location neighbor = *neighbor_it;
+            if (!is_reached[neighbor.getRow() * extent + neighbor.getColumn()]) {
+                is_reached[neighbor.getRow() * extent + neighbor.getColumn()] = true;
+                queue.push(neighbor);
+            }
+        }
+    }
+    return is_reached;
+}
+
+std::vector<RowMaskBoard::Implementation> availableImplementations() {
+    std::vector<RowMaskBoard::Implementation> implementations{RowMaskBoard::Implementation::scalar};
+    for (auto implementation : {RowMaskBoard::Implementation::sse41, RowMaskBoard::Implementation::avx2}) {
+        if (RowMaskBoard::isAvailable(implementation)) {
+            implementations.push_back(implementation);
+        }
+    }
+    return implementations;
+}
+
+std::string implementationName(RowMaskBoard::Implementation implementation) {
+    switch (implementation) {
+    case RowMaskBoard::Implementation::sse41:
+        return "sse4.1";
+    case RowMaskBoard::Implementation::avx2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
+
+} // namespace
+
+TEST(RowMaskBoardTest, floodFill_withRandomBoards_agreesWithBreadthFirstSearch) {
+    for (const int extent : {3, 7, 13, 25, 31}) {
+        for (unsigned int seed = 1; seed <= 20; ++seed) {
+            const MazeGraph graph = createRandomGraph(extent, seed);
+            const RowMaskBoard row_mask_board{graph};
+            const Location source{static_cast<int>(seed) % extent, (static_cast<int>(seed) * 7) % extent};
+            const auto expected = reachableByBreadthFirstSearch(graph, source);
+            for (auto implementation : availableImplementations()) {
+                const auto reached = row_mask_board.floodFill(RowMaskBoard::singleCell(source), implementation);
+                for (auto row = 0; row < extent; ++row) {
+                    for (auto column = 0; column < extent; ++column) {
+                        const Location location{row, column};
+                        EXPECT_EQ(RowMaskBoard::test(reached, location), expected[row * extent + column])
+                            << "for " << location << " with extent " << extent << " and seed " << seed << " ("
+                            << implementationName(implementation) << ")";
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(RowMaskBoardTest, forEachCell_visitsCellsInAscendingOrder) {
+    const MazeGraph graph = createRandomGraph(13, 1);
+    const RowMaskBoard row_mask_board{graph};
+    RowMaskBoard::Rows cells{};
+    cells[12] = RowMaskBoard::RowType{1} << 12;
+    cells[0] = RowMaskBoard::RowType{1} << 5 | RowMaskBoard::RowType{1} << 1;
+
+    std::vector<CellIndex> visited;
+    row_mask_board.forEachCell(cells, [&visited](CellIndex cell) { visited.push_back(cell); });
+
+    EXPECT_EQ(visited, (std::vector<CellIndex>{1, 5, 168}));
+}
+
+TEST(RowMaskBoardTest, bestImplementation_isAvailable) {
+    EXPECT_TRUE(RowMaskBoard::isAvailable(RowMaskBoard::bestImplementation()));
+}